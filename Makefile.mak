@@ -3,34 +3,87 @@
 #  File:       Makefile
 #  Author:     Mobin Yousefi (GitHub: github.com/mobinyousefi-cs)
 #  Created:    2025-11-26
-#  Updated:    2025-11-26
+#  Updated:    2026-10-19
 #  License:    MIT License (see LICENSE file for details)
 # ==========================================================
 
 CC      := gcc
 CFLAGS  := -std=c11 -Wall -Wextra -pedantic -O2
 INCLUDE := -I./
+LDLIBS  := -pthread
 
-SRC := \
-    src/main.c \
+ENGINE_SRC := \
     src/game.c \
     src/snake.c \
     src/board.c \
+    src/level.c \
+    src/reach.c \
+    src/tensor.c \
+    src/frame.c \
+    src/render.c \
+    src/writer.c \
+    src/session.c \
+    src/telemetry.c \
+    src/metrics.c \
+    src/policy.c \
+    src/pool.c \
     src/input.c \
     src/utils.c
 
-OBJ    := $(SRC:.c=.o)
-TARGET := snake_game
+SRC := src/main.c $(ENGINE_SRC)
 
-.PHONY: all clean
+OBJ        := $(SRC:.c=.o)
+ENGINE_OBJ := $(ENGINE_SRC:.c=.o)
+TARGET     := snake_game
+
+TOOLS := bench_move tournament multiplex bench_output mapgen bench_tensor difftest
+
+.PHONY: all bench tools fuzz clean
 
 all: $(TARGET)
 
+bench: bench_move tournament bench_output bench_tensor
+
+tools: $(TOOLS)
+
 $(TARGET): $(OBJ)
-	$(CC) $(CFLAGS) -o $@ $^
+	$(CC) $(CFLAGS) -o $@ $^ $(LDLIBS)
+
+bench_move: tools/bench_move.o $(ENGINE_OBJ)
+	$(CC) $(CFLAGS) -o $@ $^ $(LDLIBS)
+
+tournament: tools/tournament.o $(ENGINE_OBJ)
+	$(CC) $(CFLAGS) -o $@ $^ $(LDLIBS)
+
+multiplex: tools/multiplex.o $(ENGINE_OBJ)
+	$(CC) $(CFLAGS) -o $@ $^ $(LDLIBS)
+
+bench_output: tools/bench_output.o $(ENGINE_OBJ)
+	$(CC) $(CFLAGS) -o $@ $^ $(LDLIBS)
+
+mapgen: tools/mapgen.o $(ENGINE_OBJ)
+	$(CC) $(CFLAGS) -o $@ $^ $(LDLIBS)
+
+bench_tensor: tools/bench_tensor.o $(ENGINE_OBJ)
+	$(CC) $(CFLAGS) -o $@ $^ $(LDLIBS)
+
+difftest: tools/difftest.o $(ENGINE_OBJ)
+	$(CC) $(CFLAGS) -o $@ $^ $(LDLIBS)
+
+# libFuzzer build of the differential harness; needs clang.
+FUZZ_CC     := clang
+FUZZ_CFLAGS := -std=c11 -g -O1 -fsanitize=fuzzer,address,undefined -DSNAKE_LIBFUZZER
+
+fuzz: fuzz_difftest
+
+fuzz_difftest: tools/difftest.c $(ENGINE_SRC)
+	$(FUZZ_CC) $(FUZZ_CFLAGS) $(INCLUDE) -o $@ $^ $(LDLIBS)
 
 src/%.o: src/%.c
 	$(CC) $(CFLAGS) $(INCLUDE) -c $< -o $@
 
+tools/%.o: tools/%.c
+	$(CC) $(CFLAGS) $(INCLUDE) -c $< -o $@
+
 clean:
-	rm -f $(OBJ) $(TARGET)
+	rm -f $(OBJ) tools/*.o $(TARGET) $(TOOLS) fuzz_difftest
@@ -4,31 +4,104 @@
  File:       board.h
  Author:     Mobin Yousefi (GitHub: github.com/mobinyousefi-cs)
  Created:    2025-11-26
- Updated:    2025-11-26
+ Updated:    2026-10-19
  License:    MIT License (see LICENSE file for details)
 ===========================================================
 
  Description:
     Board representation and operations, including food
-    placement and boundary checks.
+    placement, boundary checks, and cell occupancy.
+
+ Notes:
+    - Occupancy is stored sparsely in BOARD_CHUNK_SIZE x
+      BOARD_CHUNK_SIZE bitmap chunks that are allocated on
+      first use and released once empty, so memory follows
+      the snake's footprint instead of the board area.
+    - Chunks are found through an open-addressing hash table
+      keyed on chunk coordinates.
+    - Boards up to BOARD_DENSE_MAX_CELLS (border included) use
+      a dense byte grid instead. It is padded by one cell of
+      CELL_WALL on every side, so the movement kernel answers
+      wall and body hits with one lookup at a linear index.
+      board_create_sparse() skips the grid at any size, so
+      the chunked path can be checked against it.
+    - A Level may be attached to add obstacles and exits. On
+      the dense grid they are stamped in as CELL_WALL and
+      CELL_EXIT, so the movement kernel is unchanged; sparse
+      boards read them from the level's mapped bit planes.
 ===========================================================
 */
 
 #ifndef BOARD_H
 #define BOARD_H
 
+#include <stddef.h>
+#include <stdint.h>
+
+#include "level.h"
 #include "snake.h"
 
+#define BOARD_CHUNK_SHIFT  6
+#define BOARD_CHUNK_SIZE   (1 << BOARD_CHUNK_SHIFT)
+
+#define BOARD_DENSE_MAX_CELLS  (1 << 24)
+
+/* Food placement tries this many random cells before scanning
+   forward from a random start. The stream is seeded with
+   utils_splitmix64() and stepped with utils_xorshift(). */
+#define BOARD_FOOD_RANDOM_ATTEMPTS  64
+
+typedef enum CellKind {
+    CELL_EMPTY = 0,
+    CELL_BODY,
+    CELL_WALL,
+    CELL_EXIT
+} CellKind;
+
+typedef struct BoardChunk BoardChunk;
+
+typedef struct BoardChunkSlot {
+    uint64_t    key;
+    BoardChunk *chunk;
+} BoardChunkSlot;
+
 typedef struct Board {
-    int      width;
-    int      height;
-    Position food;
+    int             width;
+    int             height;
+    Position        food;
+
+    unsigned char  *cells;
+    int             stride;
+    int             step[4];
+
+    BoardChunkSlot *slots;
+    size_t          slot_capacity;
+    size_t          chunk_count;
+    BoardChunk     *free_chunks;
+
+    uint64_t        rng_state;
+    const Level    *level;
 } Board;
 
-Board *board_create(int width, int height);
-void   board_destroy(Board *board);
+Board   *board_create(int width, int height);
+Board   *board_create_sparse(int width, int height);
+void     board_destroy(Board *board);
+int      board_attach_level(Board *board, const Level *level);
+
+void     board_seed(Board *board, uint64_t seed);
+uint64_t board_random(Board *board);
+
+int      board_is_inside(const Board *board, int x, int y);
+int      board_is_occupied(const Board *board, int x, int y);
+CellKind board_cell_at(const Board *board, int x, int y);
+int      board_set_occupied(Board *board, int x, int y, int occupied);
+int      board_place_food(Board *board);
 
-int    board_is_inside(const Board *board, int x, int y);
-void   board_place_food(Board *board, const Snake *snake);
+/* Linear index into the padded dense grid; only valid when
+   board->cells is set. Neighbours are index + step[direction]. */
+static inline int board_cell_index(const Board *board, int x, int y)
+{
+    return (y + 1) * board->stride + (x + 1);
+}
 
 #endif /* BOARD_H */
@@ -4,7 +4,7 @@
  File:       config.h
  Author:     Mobin Yousefi (GitHub: github.com/mobinyousefi-cs)
  Created:    2025-11-26
- Updated:    2025-11-26
+ Updated:    2026-10-19
  License:    MIT License (see LICENSE file for details)
 ===========================================================
 
@@ -20,4 +20,14 @@
 #define BOARD_HEIGHT  20
 #define GAME_TICK_MS  120
 
+#define SNAKE_INITIAL_LENGTH  4
+
+/* Size of the camera viewport drawn around the snake's head. Boards
+   smaller than the viewport are drawn in full. */
+#define VIEW_WIDTH    40
+#define VIEW_HEIGHT   20
+
+/* Interval between periodic metric exports (--stats-file). */
+#define TELEMETRY_EXPORT_MS  10000
+
 #endif /* CONFIG_H */
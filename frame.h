@@ -0,0 +1,36 @@
+/*
+===========================================================
+ Project:    Snake Game in Console
+ File:       frame.h
+ Author:     Mobin Yousefi (GitHub: github.com/mobinyousefi-cs)
+ Created:    2026-10-19
+ Updated:    2026-10-19
+ License:    MIT License (see LICENSE file for details)
+===========================================================
+
+ Description:
+    Growable byte buffer that holds one fully composed frame
+    so it can be written to the terminal in a single call.
+===========================================================
+*/
+
+#ifndef FRAME_H
+#define FRAME_H
+
+#include <stddef.h>
+
+typedef struct FrameBuffer {
+    char   *data;
+    size_t  length;
+    size_t  capacity;
+} FrameBuffer;
+
+int  frame_init(FrameBuffer *frame, size_t capacity);
+void frame_free(FrameBuffer *frame);
+void frame_reset(FrameBuffer *frame);
+
+int  frame_append(FrameBuffer *frame, const char *data, size_t length);
+int  frame_putc(FrameBuffer *frame, char ch);
+int  frame_printf(FrameBuffer *frame, const char *format, ...);
+
+#endif /* FRAME_H */
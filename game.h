@@ -4,7 +4,7 @@
  File:       game.h
  Author:     Mobin Yousefi (GitHub: github.com/mobinyousefi-cs)
  Created:    2025-11-26
- Updated:    2025-11-26
+ Updated:    2026-10-19
  License:    MIT License (see LICENSE file for details)
 ===========================================================
 
@@ -17,27 +17,66 @@
 #ifndef GAME_H
 #define GAME_H
 
+#include <stdint.h>
+
 #include "board.h"
+#include "frame.h"
+#include "reach.h"
 #include "snake.h"
 
 typedef enum GameStatus {
     GAME_RUNNING = 0,
     GAME_OVER_QUIT,
-    GAME_OVER_COLLISION
+    GAME_OVER_COLLISION,
+    GAME_OVER_EXIT
 } GameStatus;
 
+typedef enum DeathCause {
+    DEATH_NONE = 0,
+    DEATH_WALL,
+    DEATH_SELF
+} DeathCause;
+
+/* Plain per-game counters kept by game_update(); callers publish
+   them to telemetry once the game is over. */
+typedef struct GameStats {
+    unsigned long long ticks;
+    unsigned long      food_eaten;
+    DeathCause         death;
+} GameStats;
+
 typedef struct Game {
-    Board      *board;
-    Snake      *snake;
-    int         score;
-    GameStatus  status;
+    Board        *board;
+    Snake        *snake;
+    const Level  *level;
+    ReachTracker *reach;
+    int           score;
+    GameStatus    status;
+    GameStats     stats;
 } Game;
 
 Game *game_create(void);
+Game *game_create_ex(int width, int height, uint64_t seed);
+Game *game_create_sparse(int width, int height, uint64_t seed);
+Game *game_create_level(const Level *level, uint64_t seed);
 void  game_destroy(Game *game);
 
+int   game_exits_open(const Game *game);
+
+/* Reachable-area tracking is off by default; once enabled on a dense
+   board, game_update() keeps it current and the queries below are
+   O(1). game_move_area() returns -1 without a tracker. A move is
+   safe when it enters an open exit or leaves at least as much
+   reachable room as the snake is long. */
+int   game_enable_reach(Game *game);
+int   game_move_area(const Game *game, Direction dir);
+int   game_has_safe_move(const Game *game);
+
 void  game_update(Game *game);
 void  game_change_direction(Game *game, Direction dir);
+const char *game_death_name(DeathCause death);
+
 void  game_render(const Game *game);
+int   game_render_frame(const Game *game, FrameBuffer *frame);
 
 #endif /* GAME_H */
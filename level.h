@@ -0,0 +1,142 @@
+/*
+===========================================================
+ Project:    Snake Game in Console
+ File:       level.h
+ Author:     Mobin Yousefi (GitHub: github.com/mobinyousefi-cs)
+ Created:    2026-10-19
+ Updated:    2026-10-19
+ License:    MIT License (see LICENSE file for details)
+===========================================================
+
+ Description:
+    Level maps: obstacle layouts and exits loaded from a
+    compact binary file, plus static distance fields that
+    are precomputed once and cached on disk next to the map.
+
+ Notes:
+    - Map file layout (little-endian):
+          LevelHeader (32 bytes)
+          obstacle plane: height rows of words_per_row
+                          uint64_t, bit x of a row = cell x
+          exit plane:     same layout as the obstacle plane
+      The file is memory-mapped; opening a map reads only the
+      exit plane (and obstacle words under set exit bits),
+      and rejects the file if the header's exit_count does
+      not match the exits found there.
+    - Field cache "<map>" LEVEL_FIELD_SUFFIX: LevelFieldHeader
+      followed by the wall field and, if the map has exits,
+      the exit field, both uint16_t per cell in row-major
+      order. The header records a hash of the map file; a
+      stale or missing cache is rebuilt and rewritten.
+    - The wall field is the 4-neighbour step distance from a
+      cell to the nearest obstacle or board edge; the exit
+      field is the walking distance to the nearest exit
+      around obstacles, LEVEL_FIELD_UNREACHABLE where none
+      can be reached. Both saturate at 65534.
+    - Fields are only built for maps up to
+      LEVEL_FIELD_MAX_CELLS; larger maps load without them.
+      On those, the autopilot and search bots look for open
+      exits with a windowed search instead (see policy.h), so
+      an exit farther than the window is not seen, and the
+      greedy bot keeps chasing food.
+    - Exits are closed until the snake has eaten food_goal
+      items; entering an open exit clears the level.
+===========================================================
+*/
+
+#ifndef LEVEL_H
+#define LEVEL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "snake.h"
+
+#define LEVEL_MAGIC              0x4D4B4E53u  /* "SNKM" */
+#define LEVEL_FIELD_MAGIC        0x464B4E53u  /* "SNKF" */
+#define LEVEL_VERSION            1u
+#define LEVEL_FIELD_SUFFIX       ".fields"
+#define LEVEL_FIELD_MAX_CELLS    (1 << 24)
+#define LEVEL_FIELD_UNREACHABLE  0xFFFFu
+
+typedef struct LevelHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t width;
+    uint32_t height;
+    uint32_t start_x;
+    uint32_t start_y;
+    uint32_t food_goal;
+    uint32_t exit_count;
+} LevelHeader;
+
+typedef struct LevelFieldHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t width;
+    uint32_t height;
+    uint64_t map_hash;
+    uint32_t has_exit_field;
+    uint32_t reserved;
+} LevelFieldHeader;
+
+typedef struct Level {
+    int             width;
+    int             height;
+    Position        start;
+    unsigned long   food_goal;
+    unsigned long   exit_count;
+
+    size_t          words_per_row;
+    const uint64_t *obstacles;
+    const uint64_t *exits;
+
+    const uint16_t *wall_distance;
+    const uint16_t *exit_distance;
+
+    void           *map_base;
+    size_t          map_size;
+    void           *field_base;
+    size_t          field_size;
+    int             field_mapped;
+} Level;
+
+/* Plain description used to author a map file. Planes use the
+   same row layout as the file. */
+typedef struct LevelDesc {
+    int             width;
+    int             height;
+    Position        start;
+    unsigned long   food_goal;
+    const uint64_t *obstacles;
+    const uint64_t *exits;
+} LevelDesc;
+
+Level *level_load(const char *path);
+void   level_destroy(Level *level);
+int    level_save(const char *path, const LevelDesc *desc);
+
+size_t level_words_per_row(int width);
+
+static inline int level_plane_bit(const Level *level, const uint64_t *plane, int x, int y)
+{
+    return (int)((plane[(size_t)y * level->words_per_row + ((unsigned)x >> 6)] >> (x & 63)) & 1u);
+}
+
+/* Both lookups expect (x, y) inside the map. */
+static inline int level_is_obstacle(const Level *level, int x, int y)
+{
+    return level_plane_bit(level, level->obstacles, x, y);
+}
+
+static inline int level_is_exit(const Level *level, int x, int y)
+{
+    return level_plane_bit(level, level->exits, x, y);
+}
+
+/* Field lookups return LEVEL_FIELD_UNREACHABLE when the field
+   was not built or (x, y) lies outside the map. */
+unsigned level_wall_distance(const Level *level, int x, int y);
+unsigned level_exit_distance(const Level *level, int x, int y);
+
+#endif /* LEVEL_H */
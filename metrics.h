@@ -0,0 +1,100 @@
+/*
+===========================================================
+ Project:    Snake Game in Console
+ File:       metrics.h
+ Author:     Mobin Yousefi (GitHub: github.com/mobinyousefi-cs)
+ Created:    2026-10-19
+ Updated:    2026-10-19
+ License:    MIT License (see LICENSE file for details)
+===========================================================
+
+ Description:
+    Engine metric set built on the telemetry registry:
+    aggregate game outcomes, tick latency, and render output
+    for long-running unattended sessions.
+===========================================================
+*/
+
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <stdio.h>
+
+#include "game.h"
+#include "telemetry.h"
+
+/* Ticks per latency sample once a report is sampling. */
+#define METRICS_SAMPLE_EVERY  32u
+
+/* Per-game figures gathered outside game_update(), recorded
+   together with the game's own GameStats once it ends. Every
+   tick counts towards tick_count and the jitter (how late a
+   tick started against its deadline) sum and maximum. Only
+   one tick in sample_every is timed and goes to the latency
+   and jitter histograms, which are merged into the registry
+   on every flush; flushed buckets are kept in the game_*
+   histograms for the game's own JSONL record. A report that
+   nothing exports leaves sample_every at 0 and times no tick. */
+typedef struct GameReport {
+    TelemetryHistogram pending_latency;
+    TelemetryHistogram pending_jitter;
+    TelemetryHistogram game_latency;
+    TelemetryHistogram game_jitter;
+    unsigned long long tick_latency_sum;
+    unsigned long long tick_latency_max;
+    unsigned long long tick_jitter_sum;
+    unsigned long long tick_jitter_max;
+    unsigned long long tick_count;
+    unsigned long long tick_samples;
+    unsigned int       sample_every;
+    unsigned int       sample_countdown;
+    unsigned long long render_bytes;
+    unsigned long long frames_dropped;
+} GameReport;
+
+typedef struct EngineMetrics {
+    TelemetryRegistry *registry;
+    TelemetryMetric   *games;
+    TelemetryMetric   *score;
+    TelemetryMetric   *best_score;
+    TelemetryMetric   *ticks;
+    TelemetryMetric   *food;
+    TelemetryMetric   *deaths_wall;
+    TelemetryMetric   *deaths_self;
+    TelemetryMetric   *quits;
+    TelemetryMetric   *levels_cleared;
+    TelemetryMetric   *render_bytes;
+    TelemetryMetric   *frames_dropped;
+    TelemetryMetric   *tick_latency;
+    TelemetryMetric   *tick_jitter;
+} EngineMetrics;
+
+void metrics_init(EngineMetrics *metrics, TelemetryRegistry *registry);
+
+void metrics_report_reset(GameReport *report);
+void metrics_report_sample(GameReport *report, unsigned int every);
+
+/* Counts a tick and returns nonzero when it is due to be timed
+   and passed to metrics_observe_tick(). */
+static inline int metrics_count_tick(GameReport *report, unsigned long long jitter_ns)
+{
+    report->tick_count++;
+    report->tick_jitter_sum += jitter_ns;
+    if (jitter_ns > report->tick_jitter_max) {
+        report->tick_jitter_max = jitter_ns;
+    }
+    if (!report->sample_every || --report->sample_countdown) {
+        return 0;
+    }
+    report->sample_countdown = report->sample_every;
+    return 1;
+}
+
+void metrics_observe_tick(GameReport *report, unsigned long long latency_ns,
+                          unsigned long long jitter_ns);
+void metrics_flush(EngineMetrics *metrics, GameReport *report);
+void metrics_record_game(EngineMetrics *metrics, const Game *game, GameReport *report);
+int  metrics_write_game_jsonl(FILE *out, unsigned long long game_index,
+                              const Game *game, const GameReport *report);
+
+#endif /* METRICS_H */
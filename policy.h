@@ -0,0 +1,64 @@
+/*
+===========================================================
+ Project:    Snake Game in Console
+ File:       policy.h
+ Author:     Mobin Yousefi (GitHub: github.com/mobinyousefi-cs)
+ Created:    2026-10-19
+ Updated:    2026-10-19
+ License:    MIT License (see LICENSE file for details)
+===========================================================
+
+ Description:
+    Built-in steering policies (bots) that pick the next
+    direction for a Game: random, greedy-to-food, autopilot
+    (space-aware greedy), and breadth-first search.
+
+ Notes:
+    - Searches run inside a POLICY_WINDOW x POLICY_WINDOW
+      window around the head, so cost is independent of the
+      board size; cells beyond the window count as open.
+    - On a level with open exits, bots follow the exit field.
+      Maps too large for one get a windowed search for the
+      nearest exit in autopilot and search; greedy, which has
+      no scratch space, keeps its food distance there.
+    - A Policy owns its RNG and scratch buffers and is not
+      shared between threads. Scratch buffers are allocated
+      on first use, so cheap bots stay small.
+===========================================================
+*/
+
+#ifndef POLICY_H
+#define POLICY_H
+
+#include <stdint.h>
+
+#include "game.h"
+
+#define POLICY_WINDOW  128
+
+typedef enum PolicyKind {
+    POLICY_RANDOM = 0,
+    POLICY_GREEDY,
+    POLICY_AUTOPILOT,
+    POLICY_SEARCH,
+    POLICY_COUNT
+} PolicyKind;
+
+typedef struct Policy {
+    PolicyKind     kind;
+    uint64_t       rng_state;
+    unsigned int   epoch;
+    unsigned int  *stamp;
+    int           *queue;
+    unsigned char *first_move;
+} Policy;
+
+Policy     *policy_create(PolicyKind kind, uint64_t seed);
+void        policy_destroy(Policy *policy);
+
+Direction   policy_choose(Policy *policy, const Game *game);
+
+const char *policy_name(PolicyKind kind);
+int         policy_from_name(const char *name, PolicyKind *kind);
+
+#endif /* POLICY_H */
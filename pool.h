@@ -0,0 +1,56 @@
+/*
+===========================================================
+ Project:    Snake Game in Console
+ File:       pool.h
+ Author:     Mobin Yousefi (GitHub: github.com/mobinyousefi-cs)
+ Created:    2026-10-19
+ Updated:    2026-10-19
+ License:    MIT License (see LICENSE file for details)
+===========================================================
+
+ Description:
+    Work-stealing thread pool for batches of independent
+    tasks of uneven length, such as whole games.
+
+ Notes:
+    - Each worker owns a Chase-Lev deque. Owners pop from
+      the bottom; idle workers steal from the top of a
+      random victim, so long tasks never leave cores idle
+      behind a static split.
+    - The calling thread takes part as worker 0.
+    - A worker that finds every deque drained parks until the
+      next batch instead of spinning while long games finish.
+    - POOL_STATIC disables stealing, which is useful only as
+      a baseline when measuring the scheduler.
+===========================================================
+*/
+
+#ifndef POOL_H
+#define POOL_H
+
+#include <stddef.h>
+
+typedef void (*PoolTaskFn)(void *context, size_t task, int worker);
+
+typedef enum PoolSchedule {
+    POOL_STEAL = 0,
+    POOL_STATIC
+} PoolSchedule;
+
+typedef struct PoolWorkerStats {
+    unsigned long long tasks;
+    unsigned long long steals;
+    long long          busy_ns;
+} PoolWorkerStats;
+
+typedef struct WorkPool WorkPool;
+
+WorkPool *pool_create(int threads);
+void      pool_destroy(WorkPool *pool);
+
+int       pool_thread_count(const WorkPool *pool);
+int       pool_run(WorkPool *pool, size_t task_count, PoolSchedule schedule,
+                   PoolTaskFn fn, void *context);
+const PoolWorkerStats *pool_worker_stats(const WorkPool *pool, int worker);
+
+#endif /* POOL_H */
@@ -0,0 +1,83 @@
+/*
+===========================================================
+ Project:    Snake Game in Console
+ File:       reach.h
+ Author:     Mobin Yousefi (GitHub: github.com/mobinyousefi-cs)
+ Created:    2026-10-19
+ Updated:    2026-10-19
+ License:    MIT License (see LICENSE file for details)
+===========================================================
+
+ Description:
+    Incremental reachable-area tracking. Free cells of a
+    dense board are labelled by connected region, and each
+    region's size is kept up to date as the snake occupies
+    its new head cell and frees its tail, so the free area
+    reachable after any candidate move is an O(1) query.
+
+ Notes:
+    - Occupying a cell may split its region. The free
+      neighbours of the cell are searched in lockstep, one
+      expansion each in turn; searches that meet are joined,
+      and a search that runs dry has found a detached part,
+      which gets a new label. The work is bounded by the
+      smaller side of each split, never the whole board.
+    - Freeing a cell may join regions. The smaller regions
+      are relabelled into the largest.
+    - Only dense boards (board->cells) are supported. The
+      tracker reads the grid, so it must be notified of every
+      occupancy change made to the board; game_update() does
+      this when a tracker is enabled on the game.
+===========================================================
+*/
+
+#ifndef REACH_H
+#define REACH_H
+
+#include <stddef.h>
+
+#include "board.h"
+#include "snake.h"
+
+#define REACH_NO_REGION  (-1)
+
+/* A breadth-first search whose queue is threaded through the
+   tracker's link array: first..last are the cells it has seen,
+   next is the first one not expanded yet. */
+typedef struct ReachSearch {
+    int first;
+    int next;
+    int last;
+    int count;
+    int group;
+} ReachSearch;
+
+typedef struct ReachTracker {
+    const Board  *board;
+    int          *label;
+    int          *link;
+    int          *size;
+    int          *free_labels;
+    int           free_count;
+    int           label_count;
+
+    unsigned int *seen;
+    unsigned int  epoch;
+    ReachSearch   searches[4];
+
+    unsigned long long splits;
+    unsigned long long cells_searched;
+} ReachTracker;
+
+ReachTracker *reach_create(const Board *board);
+void          reach_destroy(ReachTracker *tracker);
+int           reach_rebuild(ReachTracker *tracker);
+
+void          reach_occupy(ReachTracker *tracker, int x, int y);
+void          reach_release(ReachTracker *tracker, int x, int y);
+
+int           reach_region_size(const ReachTracker *tracker, int x, int y);
+int           reach_move_area(const ReachTracker *tracker, const Snake *snake,
+                              Position food, Direction dir);
+
+#endif /* REACH_H */
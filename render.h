@@ -0,0 +1,54 @@
+/*
+===========================================================
+ Project:    Snake Game in Console
+ File:       render.h
+ Author:     Mobin Yousefi (GitHub: github.com/mobinyousefi-cs)
+ Created:    2026-10-19
+ Updated:    2026-10-19
+ License:    MIT License (see LICENSE file for details)
+===========================================================
+
+ Description:
+    Frame presentation decoupled from the simulation tick.
+    Frames are written to a non-blocking stdout; when the
+    terminal applies backpressure, intermediate frames are
+    dropped and the latest state is presented next.
+    Alternatively, frames are handed to an AsyncWriter
+    thread (renderer_init_async) that owns the blocking
+    write, so the tick thread never writes to stdout.
+===========================================================
+*/
+
+#ifndef RENDER_H
+#define RENDER_H
+
+#include "frame.h"
+#include "game.h"
+#include "writer.h"
+
+typedef struct RenderStats {
+    unsigned long long frames_presented;
+    unsigned long long frames_dropped;
+    unsigned long long bytes_written;
+    long long          last_lag_ns;
+    long long          max_lag_ns;
+} RenderStats;
+
+typedef struct Renderer {
+    FrameBuffer  frame;
+    size_t       written;
+    int          pending;
+    long long    frame_time_ns;
+    RenderStats  stats;
+    AsyncWriter *writer;
+} Renderer;
+
+int  renderer_init(Renderer *renderer);
+int  renderer_init_async(Renderer *renderer);
+void renderer_free(Renderer *renderer);
+
+void renderer_submit(Renderer *renderer, const Game *game, long long now_ns);
+int  renderer_flush(Renderer *renderer, long long now_ns);
+void renderer_finish(Renderer *renderer, long long now_ns);
+
+#endif /* RENDER_H */
@@ -0,0 +1,84 @@
+/*
+===========================================================
+ Project:    Snake Game in Console
+ File:       session.h
+ Author:     Mobin Yousefi (GitHub: github.com/mobinyousefi-cs)
+ Created:    2026-10-19
+ Updated:    2026-10-19
+ License:    MIT License (see LICENSE file for details)
+===========================================================
+
+ Description:
+    Resumable game loop. A GameSession is a small state
+    machine (input -> update -> render -> wait) that never
+    blocks: session_pump() advances it as far as the clock
+    allows and returns the next wake-up deadline, so a host
+    event loop can multiplex many sessions on one thread.
+
+ Notes:
+    - Input is pushed by the host (keyboard, network, bot)
+      and consumed one action per tick, as the terminal loop
+      always did.
+    - The renderer is optional; headless sessions pass NULL.
+    - Tick jitter is how late a tick starts against its
+      deadline, both on the host's clock (the now_ns passed
+      to session_pump()), so a cached or virtual clock stays
+      consistent with the returned deadlines. Tick latency is
+      the tick's own work, timed on the monotonic clock, and
+      only for the ticks the report samples (see
+      metrics_report_sample()); by default no tick is timed.
+    - While a frame is only partly written, the host should
+      also wake when stdout becomes writable (see
+      session_wants_output()) and pump again.
+===========================================================
+*/
+
+#ifndef SESSION_H
+#define SESSION_H
+
+#include "game.h"
+#include "input.h"
+#include "metrics.h"
+#include "render.h"
+
+#define SESSION_INPUT_QUEUE  16
+#define SESSION_DONE         (-1LL)
+
+typedef enum SessionPhase {
+    SESSION_INPUT = 0,
+    SESSION_UPDATE,
+    SESSION_RENDER,
+    SESSION_WAIT,
+    SESSION_FINISHED
+} SessionPhase;
+
+typedef struct GameSession {
+    Game        *game;
+    Renderer    *renderer;
+    SessionPhase phase;
+    long long    tick_ns;
+    long long    next_tick_ns;
+    long long    tick_start_ns;
+    long long    tick_jitter_ns;
+    long long    work_start_ns;
+    int          timing;
+
+    InputAction  inputs[SESSION_INPUT_QUEUE];
+    unsigned int input_head;
+    unsigned int input_tail;
+
+    GameReport   report;
+} GameSession;
+
+void      session_init(GameSession *session, Game *game, Renderer *renderer,
+                       long long tick_ns, long long now_ns);
+
+int       session_push_input(GameSession *session, InputAction action);
+long long session_pump(GameSession *session, long long now_ns);
+
+int       session_is_done(const GameSession *session);
+int       session_wants_output(const GameSession *session);
+
+InputAction session_turn_input(Direction dir);
+
+#endif /* SESSION_H */
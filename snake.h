@@ -4,7 +4,7 @@
  File:       snake.h
  Author:     Mobin Yousefi (GitHub: github.com/mobinyousefi-cs)
  Created:    2025-11-26
- Updated:    2025-11-26
+ Updated:    2026-10-19
  License:    MIT License (see LICENSE file for details)
 ===========================================================
 
@@ -29,6 +29,12 @@ typedef enum Direction {
     DIR_RIGHT
 } Direction;
 
+/* Lookup tables indexed by Direction, shared by the movement kernel
+   and anything else that walks neighbouring cells. */
+extern const int       SNAKE_DIR_DX[4];
+extern const int       SNAKE_DIR_DY[4];
+extern const Direction SNAKE_DIR_OPPOSITE[4];
+
 typedef struct SnakeNode {
     Position          pos;
     struct SnakeNode *next;
@@ -4,21 +4,177 @@
  File:       board.c
  Author:     Mobin Yousefi (GitHub: github.com/mobinyousefi-cs)
  Created:    2025-11-26
- Updated:    2025-11-26
+ Updated:    2026-10-19
  License:    MIT License (see LICENSE file for details)
 ===========================================================
 
  Description:
     Implementation of board operations, including creation,
-    destruction, boundary checks, and random food placement.
+    destruction, boundary checks, dense and sparse chunked
+    occupancy, level obstacles, and random food placement.
 ===========================================================
 */
 
 #include "board.h"
 
 #include <stdlib.h>
+#include <string.h>
 
-Board *board_create(int width, int height)
+#include "utils.h"
+
+#define CHUNK_MASK          (BOARD_CHUNK_SIZE - 1)
+#define INITIAL_SLOT_COUNT  16
+
+struct BoardChunk {
+    uint64_t    rows[BOARD_CHUNK_SIZE];
+    int         population;
+    BoardChunk *next_free;
+};
+
+static uint64_t chunk_key(int x, int y)
+{
+    uint32_t cx = (uint32_t)x >> BOARD_CHUNK_SHIFT;
+    uint32_t cy = (uint32_t)y >> BOARD_CHUNK_SHIFT;
+    return ((uint64_t)cy << 32) | cx;
+}
+
+static size_t slot_home(uint64_t key, size_t capacity)
+{
+    return (size_t)((key * 0x9E3779B97F4A7C15ULL) >> 32) & (capacity - 1);
+}
+
+static BoardChunk *find_chunk(const Board *board, uint64_t key)
+{
+    size_t mask = board->slot_capacity - 1;
+    size_t i    = slot_home(key, board->slot_capacity);
+
+    while (board->slots[i].chunk) {
+        if (board->slots[i].key == key) {
+            return board->slots[i].chunk;
+        }
+        i = (i + 1) & mask;
+    }
+
+    return NULL;
+}
+
+static void insert_slot(BoardChunkSlot *slots, size_t capacity,
+                        uint64_t key, BoardChunk *chunk)
+{
+    size_t i = slot_home(key, capacity);
+    while (slots[i].chunk) {
+        i = (i + 1) & (capacity - 1);
+    }
+    slots[i].key   = key;
+    slots[i].chunk = chunk;
+}
+
+static int grow_slots(Board *board)
+{
+    size_t          capacity = board->slot_capacity * 2;
+    BoardChunkSlot *slots    = (BoardChunkSlot *)calloc(capacity, sizeof(BoardChunkSlot));
+    if (!slots) {
+        return 0;
+    }
+
+    for (size_t i = 0; i < board->slot_capacity; ++i) {
+        if (board->slots[i].chunk) {
+            insert_slot(slots, capacity, board->slots[i].key, board->slots[i].chunk);
+        }
+    }
+
+    free(board->slots);
+    board->slots         = slots;
+    board->slot_capacity = capacity;
+    return 1;
+}
+
+static BoardChunk *acquire_chunk(Board *board, uint64_t key)
+{
+    if ((board->chunk_count + 1) * 2 > board->slot_capacity && !grow_slots(board)) {
+        return NULL;
+    }
+
+    BoardChunk *chunk = board->free_chunks;
+    if (chunk) {
+        board->free_chunks = chunk->next_free;
+    } else {
+        chunk = (BoardChunk *)malloc(sizeof(BoardChunk));
+        if (!chunk) {
+            return NULL;
+        }
+    }
+
+    memset(chunk->rows, 0, sizeof(chunk->rows));
+    chunk->population = 0;
+    chunk->next_free  = NULL;
+
+    insert_slot(board->slots, board->slot_capacity, key, chunk);
+    board->chunk_count++;
+    return chunk;
+}
+
+/* Removes an empty chunk using backward-shift deletion so the
+   probe sequences of the remaining entries stay intact. */
+static void release_chunk(Board *board, uint64_t key)
+{
+    size_t mask = board->slot_capacity - 1;
+    size_t i    = slot_home(key, board->slot_capacity);
+
+    while (board->slots[i].key != key || !board->slots[i].chunk) {
+        i = (i + 1) & mask;
+    }
+
+    BoardChunk *chunk  = board->slots[i].chunk;
+    chunk->next_free   = board->free_chunks;
+    board->free_chunks = chunk;
+    board->chunk_count--;
+
+    size_t j = i;
+    for (;;) {
+        board->slots[i].chunk = NULL;
+
+        for (;;) {
+            j = (j + 1) & mask;
+            if (!board->slots[j].chunk) {
+                return;
+            }
+
+            size_t home = slot_home(board->slots[j].key, board->slot_capacity);
+            if (((j - home) & mask) >= ((j - i) & mask)) {
+                break;
+            }
+        }
+
+        board->slots[i] = board->slots[j];
+        i = j;
+    }
+}
+
+static int create_dense_cells(Board *board)
+{
+    const int stride = board->width + 2;
+    const int rows   = board->height + 2;
+
+    board->cells = (unsigned char *)malloc((size_t)stride * (size_t)rows);
+    if (!board->cells) {
+        return 0;
+    }
+
+    memset(board->cells, CELL_WALL, (size_t)stride * (size_t)rows);
+    for (int y = 0; y < board->height; ++y) {
+        memset(board->cells + (size_t)(y + 1) * stride + 1, CELL_EMPTY, (size_t)board->width);
+    }
+
+    board->stride          = stride;
+    board->step[DIR_UP]    = -stride;
+    board->step[DIR_DOWN]  = stride;
+    board->step[DIR_LEFT]  = -1;
+    board->step[DIR_RIGHT] = 1;
+    return 1;
+}
+
+static Board *create_board(int width, int height, int allow_dense)
 {
     if (width <= 0 || height <= 0) {
         return NULL;
@@ -29,44 +185,234 @@ Board *board_create(int width, int height)
         return NULL;
     }
 
-    board->width  = width;
-    board->height = height;
-    board->food.x = width / 2;
-    board->food.y = height / 2;
+    board->width         = width;
+    board->height        = height;
+    board->food.x        = width / 2;
+    board->food.y        = height / 2;
+    board->cells         = NULL;
+    board->stride        = 0;
+    board->slot_capacity = INITIAL_SLOT_COUNT;
+    board->chunk_count   = 0;
+    board->free_chunks   = NULL;
+    board->level         = NULL;
+
+    for (int d = 0; d < 4; ++d) {
+        board->step[d] = 0;
+    }
+
+    long long padded = ((long long)width + 2) * ((long long)height + 2);
+    if (allow_dense && padded <= BOARD_DENSE_MAX_CELLS && !create_dense_cells(board)) {
+        free(board);
+        return NULL;
+    }
+
+    board->slots = (BoardChunkSlot *)calloc(INITIAL_SLOT_COUNT, sizeof(BoardChunkSlot));
+    if (!board->slots) {
+        free(board->cells);
+        free(board);
+        return NULL;
+    }
+
+    board_seed(board, 0);
 
     return board;
 }
 
+Board *board_create(int width, int height)
+{
+    return create_board(width, height, 1);
+}
+
+Board *board_create_sparse(int width, int height)
+{
+    return create_board(width, height, 0);
+}
+
 void board_destroy(Board *board)
 {
     if (!board) {
         return;
     }
+
+    for (size_t i = 0; i < board->slot_capacity; ++i) {
+        free(board->slots[i].chunk);
+    }
+
+    BoardChunk *chunk = board->free_chunks;
+    while (chunk) {
+        BoardChunk *next = chunk->next_free;
+        free(chunk);
+        chunk = next;
+    }
+
+    free(board->slots);
+    free(board->cells);
     free(board);
 }
 
+int board_attach_level(Board *board, const Level *level)
+{
+    if (!board || !level || level->width != board->width || level->height != board->height) {
+        return 0;
+    }
+
+    board->level = level;
+    if (!board->cells) {
+        return 1;
+    }
+
+    for (int y = 0; y < board->height; ++y) {
+        unsigned char *row = board->cells + board_cell_index(board, 0, y);
+        for (int x = 0; x < board->width; ++x) {
+            if (level_is_obstacle(level, x, y)) {
+                row[x] = CELL_WALL;
+            } else if (level_is_exit(level, x, y)) {
+                row[x] = CELL_EXIT;
+            }
+        }
+    }
+
+    return 1;
+}
+
+void board_seed(Board *board, uint64_t seed)
+{
+    if (!board) {
+        return;
+    }
+
+    board->rng_state = utils_splitmix64(seed);
+}
+
+uint64_t board_random(Board *board)
+{
+    return utils_xorshift(&board->rng_state);
+}
+
 int board_is_inside(const Board *board, int x, int y)
 {
     if (!board) {
         return 0;
     }
 
-    return (x >= 0 && x < board->width && y >= 0 && y < board->height);
+    return ((unsigned)x < (unsigned)board->width) & ((unsigned)y < (unsigned)board->height);
 }
 
-void board_place_food(Board *board, const Snake *snake)
+int board_is_occupied(const Board *board, int x, int y)
+{
+    if (!board_is_inside(board, x, y)) {
+        return 0;
+    }
+
+    if (board->cells) {
+        return board->cells[board_cell_index(board, x, y)] == CELL_BODY;
+    }
+
+    const BoardChunk *chunk = find_chunk(board, chunk_key(x, y));
+    if (!chunk) {
+        return 0;
+    }
+
+    return (int)((chunk->rows[y & CHUNK_MASK] >> (x & CHUNK_MASK)) & 1u);
+}
+
+CellKind board_cell_at(const Board *board, int x, int y)
+{
+    if (!board_is_inside(board, x, y)) {
+        return CELL_WALL;
+    }
+
+    if (board->cells) {
+        return (CellKind)board->cells[board_cell_index(board, x, y)];
+    }
+
+    if (board->level) {
+        if (level_is_obstacle(board->level, x, y)) {
+            return CELL_WALL;
+        }
+        if (level_is_exit(board->level, x, y)) {
+            return CELL_EXIT;
+        }
+    }
+
+    return board_is_occupied(board, x, y) ? CELL_BODY : CELL_EMPTY;
+}
+
+int board_set_occupied(Board *board, int x, int y, int occupied)
+{
+    if (!board_is_inside(board, x, y)) {
+        return 0;
+    }
+
+    if (board->cells) {
+        board->cells[board_cell_index(board, x, y)] =
+            (unsigned char)(occupied ? CELL_BODY : CELL_EMPTY);
+        return 1;
+    }
+
+    uint64_t    key   = chunk_key(x, y);
+    BoardChunk *chunk = find_chunk(board, key);
+
+    if (!chunk) {
+        if (!occupied) {
+            return 1;
+        }
+        chunk = acquire_chunk(board, key);
+        if (!chunk) {
+            return 0;
+        }
+    }
+
+    uint64_t *row = &chunk->rows[y & CHUNK_MASK];
+    uint64_t  bit = (uint64_t)1 << (x & CHUNK_MASK);
+
+    if (occupied && !(*row & bit)) {
+        *row |= bit;
+        chunk->population++;
+    } else if (!occupied && (*row & bit)) {
+        *row &= ~bit;
+        if (--chunk->population == 0) {
+            release_chunk(board, key);
+        }
+    }
+
+    return 1;
+}
+
+int board_place_food(Board *board)
 {
     if (!board) {
-        return;
+        return 0;
+    }
+
+    /* Random probes only look up the chunk of the probed cell, so on
+       a sparse board this succeeds almost immediately. */
+    for (int i = 0; i < BOARD_FOOD_RANDOM_ATTEMPTS; ++i) {
+        int x = (int)(board_random(board) % (uint64_t)board->width);
+        int y = (int)(board_random(board) % (uint64_t)board->height);
+
+        if (board_cell_at(board, x, y) == CELL_EMPTY) {
+            board->food.x = x;
+            board->food.y = y;
+            return 1;
+        }
     }
 
-    int x, y;
+    /* Crowded board: walk forward from a random cell to the next free one. */
+    long long total = (long long)board->width * board->height;
+    long long start = (long long)(board_random(board) % (uint64_t)total);
 
-    do {
-        x = rand() % board->width;
-        y = rand() % board->height;
-    } while (snake && snake_occupies(snake, x, y));
+    for (long long i = 0; i < total; ++i) {
+        long long cell = (start + i) % total;
+        int       x    = (int)(cell % board->width);
+        int       y    = (int)(cell / board->width);
+
+        if (board_cell_at(board, x, y) == CELL_EMPTY) {
+            board->food.x = x;
+            board->food.y = y;
+            return 1;
+        }
+    }
 
-    board->food.x = x;
-    board->food.y = y;
+    return 0;
 }
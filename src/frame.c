@@ -0,0 +1,120 @@
+/*
+===========================================================
+ Project:    Snake Game in Console
+ File:       frame.c
+ Author:     Mobin Yousefi (GitHub: github.com/mobinyousefi-cs)
+ Created:    2026-10-19
+ Updated:    2026-10-19
+ License:    MIT License (see LICENSE file for details)
+===========================================================
+
+ Description:
+    Implementation of the frame buffer used to compose
+    terminal output before it is written.
+===========================================================
+*/
+
+#include "frame.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int reserve(FrameBuffer *frame, size_t extra)
+{
+    size_t needed = frame->length + extra;
+    if (needed <= frame->capacity) {
+        return 1;
+    }
+
+    size_t capacity = frame->capacity ? frame->capacity : 256;
+    while (capacity < needed) {
+        capacity *= 2;
+    }
+
+    char *data = (char *)realloc(frame->data, capacity);
+    if (!data) {
+        return 0;
+    }
+
+    frame->data     = data;
+    frame->capacity = capacity;
+    return 1;
+}
+
+int frame_init(FrameBuffer *frame, size_t capacity)
+{
+    if (!frame) {
+        return 0;
+    }
+
+    frame->data     = NULL;
+    frame->length   = 0;
+    frame->capacity = 0;
+
+    return reserve(frame, capacity);
+}
+
+void frame_free(FrameBuffer *frame)
+{
+    if (!frame) {
+        return;
+    }
+
+    free(frame->data);
+    frame->data     = NULL;
+    frame->length   = 0;
+    frame->capacity = 0;
+}
+
+void frame_reset(FrameBuffer *frame)
+{
+    if (frame) {
+        frame->length = 0;
+    }
+}
+
+int frame_append(FrameBuffer *frame, const char *data, size_t length)
+{
+    if (!frame || !reserve(frame, length)) {
+        return 0;
+    }
+
+    memcpy(frame->data + frame->length, data, length);
+    frame->length += length;
+    return 1;
+}
+
+int frame_putc(FrameBuffer *frame, char ch)
+{
+    if (!frame || !reserve(frame, 1)) {
+        return 0;
+    }
+
+    frame->data[frame->length++] = ch;
+    return 1;
+}
+
+int frame_printf(FrameBuffer *frame, const char *format, ...)
+{
+    if (!frame) {
+        return 0;
+    }
+
+    va_list args;
+    va_start(args, format);
+    int needed = vsnprintf(NULL, 0, format, args);
+    va_end(args);
+
+    if (needed < 0 || !reserve(frame, (size_t)needed + 1)) {
+        return 0;
+    }
+
+    va_start(args, format);
+    vsnprintf(frame->data + frame->length, (size_t)needed + 1, format, args);
+    va_end(args);
+
+    frame->length += (size_t)needed;
+    return 1;
+}
@@ -4,13 +4,13 @@
  File:       game.c
  Author:     Mobin Yousefi (GitHub: github.com/mobinyousefi-cs)
  Created:    2025-11-26
- Updated:    2025-11-26
+ Updated:    2026-10-19
  License:    MIT License (see LICENSE file for details)
 ===========================================================
 
  Description:
     Implements the core game logic: initialization, update,
-    collision handling, scoring, and rendering.
+    collision handling, scoring, level exits, and rendering.
 ===========================================================
 */
 
@@ -23,45 +23,99 @@
 #include "config.h"
 #include "utils.h"
 
+#define ANSI_CURSOR_HOME  "\033[H"
+#define ANSI_CLEAR_LINE   "\033[K"
+#define ANSI_CLEAR_BELOW  "\033[J"
+
 Game *game_create(void)
+{
+    return game_create_ex(BOARD_WIDTH, BOARD_HEIGHT, (uint64_t)time(NULL));
+}
+
+static Game *create_game(int width, int height, uint64_t seed, const Level *level,
+                         Position start, int sparse)
 {
     Game *game = (Game *)malloc(sizeof(Game));
     if (!game) {
         return NULL;
     }
 
-    srand((unsigned int)time(NULL));
-
-    game->board = board_create(BOARD_WIDTH, BOARD_HEIGHT);
-    if (!game->board) {
+    game->board = sparse ? board_create_sparse(width, height) : board_create(width, height);
+    if (!game->board || (level && !board_attach_level(game->board, level))) {
+        board_destroy(game->board);
         free(game);
         return NULL;
     }
 
-    const int start_x = BOARD_WIDTH / 2;
-    const int start_y = BOARD_HEIGHT / 2;
+    board_seed(game->board, seed);
 
-    game->snake = snake_create(start_x, start_y, DIR_RIGHT, 4);
+    game->level = level;
+    game->reach = NULL;
+    game->snake = snake_create(start.x, start.y, DIR_RIGHT, SNAKE_INITIAL_LENGTH);
     if (!game->snake) {
         board_destroy(game->board);
         free(game);
         return NULL;
     }
 
-    game->score  = 0;
-    game->status = GAME_RUNNING;
+    for (const SnakeNode *node = game->snake->head; node; node = node->next) {
+        if (board_cell_at(game->board, node->pos.x, node->pos.y) != CELL_EMPTY ||
+            !board_set_occupied(game->board, node->pos.x, node->pos.y, 1)) {
+            game_destroy(game);
+            return NULL;
+        }
+    }
+
+    game->score            = 0;
+    game->status           = GAME_RUNNING;
+    game->stats.ticks      = 0;
+    game->stats.food_eaten = 0;
+    game->stats.death      = DEATH_NONE;
 
-    board_place_food(game->board, game->snake);
+    board_place_food(game->board);
 
     return game;
 }
 
+Game *game_create_ex(int width, int height, uint64_t seed)
+{
+    if (width / 2 < SNAKE_INITIAL_LENGTH - 1 || height <= 0) {
+        return NULL;
+    }
+
+    Position start = { width / 2, height / 2 };
+    return create_game(width, height, seed, NULL, start, 0);
+}
+
+/* Same game as game_create_ex() on a chunked board of any size. */
+Game *game_create_sparse(int width, int height, uint64_t seed)
+{
+    if (width / 2 < SNAKE_INITIAL_LENGTH - 1 || height <= 0) {
+        return NULL;
+    }
+
+    Position start = { width / 2, height / 2 };
+    return create_game(width, height, seed, NULL, start, 1);
+}
+
+/* The snake starts at the level's start cell facing right, with its
+   body trailing to the left; those cells must be free. */
+Game *game_create_level(const Level *level, uint64_t seed)
+{
+    if (!level || level->start.x < SNAKE_INITIAL_LENGTH - 1) {
+        return NULL;
+    }
+
+    return create_game(level->width, level->height, seed, level, level->start, 0);
+}
+
 void game_destroy(Game *game)
 {
     if (!game) {
         return;
     }
 
+    reach_destroy(game->reach);
     snake_destroy(game->snake);
     board_destroy(game->board);
     free(game);
@@ -76,37 +130,135 @@ void game_change_direction(Game *game, Direction dir)
     snake_set_direction(game->snake, dir);
 }
 
+int game_exits_open(const Game *game)
+{
+    return game && game->level && game->level->exit_count > 0 &&
+           game->stats.food_eaten >= game->level->food_goal;
+}
+
 void game_update(Game *game)
 {
     if (!game || game->status != GAME_RUNNING) {
         return;
     }
 
-    Position next = snake_next_head_position(game->snake);
+    const Board   *board = game->board;
+    const Position head  = game->snake->head->pos;
+    const Position next  = snake_next_head_position(game->snake);
 
-    if (!board_is_inside(game->board, next.x, next.y)) {
-        game->status = GAME_OVER_COLLISION;
-        return;
+    game->stats.ticks++;
+
+    CellKind hit;
+    if (board->cells) {
+        /* The padded grid holds walls and body alike, so a collision of
+           either kind is a single lookup at the neighbouring index. */
+        hit = (CellKind)board->cells[board_cell_index(board, head.x, head.y) +
+                                     board->step[game->snake->dir]];
+    } else {
+        hit = board_cell_at(board, next.x, next.y);
     }
 
-    if (snake_occupies(game->snake, next.x, next.y)) {
-        game->status = GAME_OVER_COLLISION;
+    if (hit != CELL_EMPTY) {
+        if (hit == CELL_EXIT && game_exits_open(game)) {
+            game->status = GAME_OVER_EXIT;
+            return;
+        }
+        /* A closed exit is as solid as a wall. */
+        game->status      = GAME_OVER_COLLISION;
+        game->stats.death = (hit == CELL_BODY) ? DEATH_SELF : DEATH_WALL;
         return;
     }
 
-    int grow = 0;
-    if (next.x == game->board->food.x && next.y == game->board->food.y) {
-        grow = 1;
-        game->score += 10;
-    }
+    const int      grow = (next.x == board->food.x && next.y == board->food.y);
+    const Position tail = game->snake->tail->pos;
 
+    /* Claim the cell first: on a sparse board it may need a chunk,
+       and a failed move is undone, so the board and the snake list
+       never disagree when the game stops on allocation failure. */
+    if (!board_set_occupied(game->board, next.x, next.y, 1)) {
+        game->status = GAME_OVER_COLLISION;
+        return;
+    }
     if (!snake_move(game->snake, grow)) {
+        board_set_occupied(game->board, next.x, next.y, 0);
         game->status = GAME_OVER_COLLISION;
         return;
     }
+    reach_occupy(game->reach, next.x, next.y);
 
     if (grow) {
-        board_place_food(game->board, game->snake);
+        game->score += 10;
+        game->stats.food_eaten++;
+        board_place_food(game->board);
+    } else {
+        board_set_occupied(game->board, tail.x, tail.y, 0);
+        reach_release(game->reach, tail.x, tail.y);
+    }
+}
+
+int game_enable_reach(Game *game)
+{
+    if (!game) {
+        return 0;
+    }
+
+    if (!game->reach) {
+        game->reach = reach_create(game->board);
+    }
+    return game->reach != NULL;
+}
+
+int game_move_area(const Game *game, Direction dir)
+{
+    if (!game || !game->reach) {
+        return -1;
+    }
+
+    return reach_move_area(game->reach, game->snake, game->board->food, dir);
+}
+
+int game_has_safe_move(const Game *game)
+{
+    if (!game || game->status != GAME_RUNNING) {
+        return 0;
+    }
+
+    const Position head = game->snake->head->pos;
+
+    for (int d = 0; d < 4; ++d) {
+        if ((Direction)d == SNAKE_DIR_OPPOSITE[game->snake->dir]) {
+            continue;
+        }
+
+        CellKind cell = board_cell_at(game->board, head.x + SNAKE_DIR_DX[d],
+                                      head.y + SNAKE_DIR_DY[d]);
+        if (cell == CELL_EXIT && game_exits_open(game)) {
+            return 1;
+        }
+        if (cell != CELL_EMPTY) {
+            continue;
+        }
+
+        /* Without a tracker only immediate death can be ruled out. */
+        int area = game_move_area(game, (Direction)d);
+        if (area < 0 || area >= game->snake->length) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+const char *game_death_name(DeathCause death)
+{
+    switch (death) {
+    case DEATH_WALL:
+        return "wall";
+    case DEATH_SELF:
+        return "self";
+    case DEATH_NONE:
+    default:
+        return "none";
     }
 }
 
@@ -116,49 +268,100 @@ static char cell_symbol(const Game *game, int x, int y)
         return '*';
     }
 
-    const SnakeNode *node = game->snake->head;
-    while (node) {
-        if (node->pos.x == x && node->pos.y == y) {
-            return (node == game->snake->head) ? 'O' : 'o';
-        }
-        node = node->next;
+    switch (board_cell_at(game->board, x, y)) {
+    case CELL_EMPTY:
+        return ' ';
+    case CELL_WALL:
+        return '#';
+    case CELL_EXIT:
+        return game_exits_open(game) ? 'E' : '=';
+    case CELL_BODY:
+    default:
+        break;
     }
 
-    return ' ';
+    const Position head = game->snake->head->pos;
+    return (head.x == x && head.y == y) ? 'O' : 'o';
 }
 
-void game_render(const Game *game)
+/* Edges of the viewport that coincide with a wall are drawn solid;
+   edges that cut through a larger board are drawn dotted. */
+static void render_horizontal_edge(FrameBuffer *frame, int view_w, int is_wall)
 {
-    if (!game) {
-        return;
+    frame_putc(frame, '+');
+    for (int x = 0; x < view_w; ++x) {
+        frame_putc(frame, is_wall ? '-' : '.');
+    }
+    frame_append(frame, "+" ANSI_CLEAR_LINE "\n", sizeof(ANSI_CLEAR_LINE) + 1);
+}
+
+int game_render_frame(const Game *game, FrameBuffer *frame)
+{
+    if (!game || !frame) {
+        return 0;
     }
 
-    utils_clear_screen();
+    const Board   *board = game->board;
+    const Position head  = game->snake->head->pos;
+
+    const int view_w = (board->width < VIEW_WIDTH) ? board->width : VIEW_WIDTH;
+    const int view_h = (board->height < VIEW_HEIGHT) ? board->height : VIEW_HEIGHT;
+    const int cam_x  = utils_clamp_origin(head.x, view_w, board->width);
+    const int cam_y  = utils_clamp_origin(head.y, view_h, board->height);
 
-    printf("Score: %d\n", game->score);
+    const char left_edge  = (cam_x == 0) ? '|' : ':';
+    const char right_edge = (cam_x + view_w == board->width) ? '|' : ':';
 
-    putchar('+');
-    for (int x = 0; x < game->board->width; ++x) {
-        putchar('-');
+    /* Redraw in place instead of clearing, so a frame is one write
+       and the terminal never shows a blank screen between frames. */
+    frame_append(frame, ANSI_CURSOR_HOME, sizeof(ANSI_CURSOR_HOME) - 1);
+
+    if (view_w == board->width && view_h == board->height) {
+        frame_printf(frame, "Score: %d", game->score);
+    } else {
+        frame_printf(frame, "Score: %d  Head: (%d, %d) of %dx%d",
+                     game->score, head.x, head.y, board->width, board->height);
     }
-    putchar('+');
-    putchar('\n');
 
-    for (int y = 0; y < game->board->height; ++y) {
-        putchar('|');
-        for (int x = 0; x < game->board->width; ++x) {
-            putchar(cell_symbol(game, x, y));
+    if (game->level && game->level->exit_count > 0) {
+        if (game_exits_open(game)) {
+            frame_printf(frame, "  Exit open (E)");
+        } else {
+            frame_printf(frame, "  Food: %lu/%lu", game->stats.food_eaten,
+                         game->level->food_goal);
         }
-        putchar('|');
-        putchar('\n');
+    }
+    frame_append(frame, ANSI_CLEAR_LINE "\n", sizeof(ANSI_CLEAR_LINE));
+
+    render_horizontal_edge(frame, view_w, cam_y == 0);
+
+    for (int y = cam_y; y < cam_y + view_h; ++y) {
+        frame_putc(frame, left_edge);
+        for (int x = cam_x; x < cam_x + view_w; ++x) {
+            frame_putc(frame, cell_symbol(game, x, y));
+        }
+        frame_putc(frame, right_edge);
+        frame_putc(frame, '\n');
+    }
+
+    render_horizontal_edge(frame, view_w, cam_y + view_h == board->height);
+
+    return frame_printf(frame, "Controls: W/A/S/D to move, Q to quit." ANSI_CLEAR_LINE "\n");
+}
+
+void game_render(const Game *game)
+{
+    FrameBuffer frame;
+
+    if (!game || !frame_init(&frame, 4096)) {
+        return;
     }
 
-    putchar('+');
-    for (int x = 0; x < game->board->width; ++x) {
-        putchar('-');
+    if (game_render_frame(game, &frame)) {
+        frame_append(&frame, ANSI_CLEAR_BELOW, sizeof(ANSI_CLEAR_BELOW) - 1);
+        fwrite(frame.data, 1, frame.length, stdout);
+        fflush(stdout);
     }
-    putchar('+');
-    putchar('\n');
 
-    printf("Controls: W/A/S/D to move, Q to quit.\n");
+    frame_free(&frame);
 }
@@ -0,0 +1,531 @@
+/*
+===========================================================
+ Project:    Snake Game in Console
+ File:       level.c
+ Author:     Mobin Yousefi (GitHub: github.com/mobinyousefi-cs)
+ Created:    2026-10-19
+ Updated:    2026-10-19
+ License:    MIT License (see LICENSE file for details)
+===========================================================
+
+ Description:
+    Loads level maps by memory-mapping them, validates the
+    header against the file size, and builds or reuses the
+    on-disk cache of wall and exit distance fields.
+===========================================================
+*/
+
+#ifndef _WIN32
+#  define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "level.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+#define TEMP_SUFFIX       ".tmp"
+#define FIELD_SATURATION  0xFFFEu
+#define PATH_CAPACITY     4096
+
+/* ---------------------------------------------------------
+   File mapping
+   --------------------------------------------------------- */
+
+#ifdef _WIN32
+
+/* No mmap: the file is read into memory instead. */
+static void *map_file(const char *path, size_t *size)
+{
+    FILE *in = fopen(path, "rb");
+    if (!in) {
+        return NULL;
+    }
+
+    void *data = NULL;
+    long  end  = (fseek(in, 0, SEEK_END) == 0) ? ftell(in) : -1;
+
+    if (end > 0 && fseek(in, 0, SEEK_SET) == 0) {
+        data = malloc((size_t)end);
+        if (data && fread(data, 1, (size_t)end, in) != (size_t)end) {
+            free(data);
+            data = NULL;
+        }
+    }
+
+    fclose(in);
+    *size = data ? (size_t)end : 0;
+    return data;
+}
+
+static void unmap_file(void *base, size_t size)
+{
+    (void)size;
+    free(base);
+}
+
+#else
+
+static void *map_file(const char *path, size_t *size)
+{
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return NULL;
+    }
+
+    struct stat info;
+    void       *base = NULL;
+
+    if (fstat(fd, &info) == 0 && info.st_size > 0) {
+        base = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (base == MAP_FAILED) {
+            base = NULL;
+        }
+    }
+
+    close(fd);
+    *size = base ? (size_t)info.st_size : 0;
+    return base;
+}
+
+static void unmap_file(void *base, size_t size)
+{
+    munmap(base, size);
+}
+
+#endif
+
+static uint64_t hash_bytes(const void *data, size_t size)
+{
+    const unsigned char *bytes = (const unsigned char *)data;
+    uint64_t             hash  = 0xCBF29CE484222325ULL;
+
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ bytes[i]) * 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+static int field_path(const char *path, char *out)
+{
+    size_t length = strlen(path);
+    if (length + sizeof(LEVEL_FIELD_SUFFIX) + sizeof(TEMP_SUFFIX) > PATH_CAPACITY) {
+        return 0;
+    }
+
+    memcpy(out, path, length);
+    memcpy(out + length, LEVEL_FIELD_SUFFIX, sizeof(LEVEL_FIELD_SUFFIX));
+    return 1;
+}
+
+/* Writes `size` bytes aside and renames them into place, so a
+   reader never maps a half-written file. */
+static int write_file_atomic(const char *path, const void *data, size_t size)
+{
+    char   temp[PATH_CAPACITY];
+    size_t length = strlen(path);
+    if (length + sizeof(TEMP_SUFFIX) > sizeof(temp)) {
+        return 0;
+    }
+    memcpy(temp, path, length);
+    memcpy(temp + length, TEMP_SUFFIX, sizeof(TEMP_SUFFIX));
+
+    FILE *out = fopen(temp, "wb");
+    if (!out) {
+        return 0;
+    }
+
+    int ok = fwrite(data, 1, size, out) == size;
+    ok     = (fclose(out) == 0) && ok;
+    if (!ok) {
+        remove(temp);
+        return 0;
+    }
+
+#ifdef _WIN32
+    remove(path);
+#endif
+    return rename(temp, path) == 0;
+}
+
+/* ---------------------------------------------------------
+   Distance fields
+   --------------------------------------------------------- */
+
+static void relax_neighbours(const Level *level, uint16_t *field, uint32_t *queue,
+                             size_t *tail, uint32_t cell, int allow_obstacles)
+{
+    const int      x    = (int)(cell % (uint32_t)level->width);
+    const int      y    = (int)(cell / (uint32_t)level->width);
+    const unsigned next = (field[cell] < FIELD_SATURATION) ? field[cell] + 1u : FIELD_SATURATION;
+
+    for (int d = 0; d < 4; ++d) {
+        int nx = x + SNAKE_DIR_DX[d];
+        int ny = y + SNAKE_DIR_DY[d];
+
+        if ((unsigned)nx >= (unsigned)level->width || (unsigned)ny >= (unsigned)level->height) {
+            continue;
+        }
+
+        uint32_t neighbour = (uint32_t)ny * (uint32_t)level->width + (uint32_t)nx;
+        if (field[neighbour] != LEVEL_FIELD_UNREACHABLE) {
+            continue;
+        }
+        if (!allow_obstacles && level_is_obstacle(level, nx, ny)) {
+            continue;
+        }
+
+        field[neighbour]  = (uint16_t)next;
+        queue[(*tail)++] = neighbour;
+    }
+}
+
+/* Multi-source BFS from every obstacle (distance 0) and from every
+   free edge cell (distance 1, one step off the board). Seeds are
+   queued in distance order, so the queue stays monotone. */
+static void build_wall_field(const Level *level, uint16_t *field, uint32_t *queue)
+{
+    const size_t cells = (size_t)level->width * (size_t)level->height;
+    size_t       head  = 0;
+    size_t       tail  = 0;
+
+    for (size_t i = 0; i < cells; ++i) {
+        field[i] = LEVEL_FIELD_UNREACHABLE;
+    }
+
+    for (int y = 0; y < level->height; ++y) {
+        for (int x = 0; x < level->width; ++x) {
+            if (level_is_obstacle(level, x, y)) {
+                uint32_t cell = (uint32_t)y * (uint32_t)level->width + (uint32_t)x;
+                field[cell]   = 0;
+                queue[tail++] = cell;
+            }
+        }
+    }
+
+    for (int y = 0; y < level->height; ++y) {
+        for (int x = 0; x < level->width; ++x) {
+            uint32_t cell = (uint32_t)y * (uint32_t)level->width + (uint32_t)x;
+            int      edge = (x == 0 || y == 0 || x == level->width - 1 || y == level->height - 1);
+
+            if (edge && field[cell] == LEVEL_FIELD_UNREACHABLE) {
+                field[cell]   = 1;
+                queue[tail++] = cell;
+            }
+        }
+    }
+
+    while (head < tail) {
+        relax_neighbours(level, field, queue, &tail, queue[head++], 1);
+    }
+}
+
+/* Walking distance to the nearest exit, around obstacles. */
+static void build_exit_field(const Level *level, uint16_t *field, uint32_t *queue)
+{
+    const size_t cells = (size_t)level->width * (size_t)level->height;
+    size_t       head  = 0;
+    size_t       tail  = 0;
+
+    for (size_t i = 0; i < cells; ++i) {
+        field[i] = LEVEL_FIELD_UNREACHABLE;
+    }
+
+    for (int y = 0; y < level->height; ++y) {
+        for (int x = 0; x < level->width; ++x) {
+            if (level_is_exit(level, x, y) && !level_is_obstacle(level, x, y)) {
+                uint32_t cell = (uint32_t)y * (uint32_t)level->width + (uint32_t)x;
+                field[cell]   = 0;
+                queue[tail++] = cell;
+            }
+        }
+    }
+
+    while (head < tail) {
+        relax_neighbours(level, field, queue, &tail, queue[head++], 0);
+    }
+}
+
+static int field_header_matches(const LevelFieldHeader *header, const Level *level,
+                                uint64_t map_hash, size_t size, size_t expected)
+{
+    return size == expected &&
+           header->magic == LEVEL_FIELD_MAGIC &&
+           header->version == LEVEL_VERSION &&
+           header->width == (uint32_t)level->width &&
+           header->height == (uint32_t)level->height &&
+           header->map_hash == map_hash &&
+           header->has_exit_field == (level->exit_count > 0);
+}
+
+static int attach_fields(Level *level, const char *path)
+{
+    const size_t cells      = (size_t)level->width * (size_t)level->height;
+    const int    has_exit   = level->exit_count > 0;
+    const size_t field_size = sizeof(LevelFieldHeader) +
+                              cells * sizeof(uint16_t) * (has_exit ? 2u : 1u);
+    const uint64_t map_hash = hash_bytes(level->map_base, level->map_size);
+
+    char cache[PATH_CAPACITY];
+    if (!field_path(path, cache)) {
+        return 0;
+    }
+
+    size_t mapped_size = 0;
+    void  *mapped      = map_file(cache, &mapped_size);
+
+    if (mapped && mapped_size >= sizeof(LevelFieldHeader) &&
+        field_header_matches((const LevelFieldHeader *)mapped, level, map_hash,
+                             mapped_size, field_size)) {
+        level->field_base   = mapped;
+        level->field_size   = mapped_size;
+        level->field_mapped = 1;
+    } else {
+        if (mapped) {
+            unmap_file(mapped, mapped_size);
+        }
+
+        unsigned char *block = (unsigned char *)malloc(field_size);
+        uint32_t      *queue = (uint32_t *)malloc(cells * sizeof(uint32_t));
+        if (!block || !queue) {
+            free(block);
+            free(queue);
+            return 0;
+        }
+
+        LevelFieldHeader header;
+        memset(&header, 0, sizeof(header));
+        header.magic          = LEVEL_FIELD_MAGIC;
+        header.version        = LEVEL_VERSION;
+        header.width          = (uint32_t)level->width;
+        header.height         = (uint32_t)level->height;
+        header.map_hash       = map_hash;
+        header.has_exit_field = (uint32_t)has_exit;
+        memcpy(block, &header, sizeof(header));
+
+        uint16_t *fields = (uint16_t *)(block + sizeof(LevelFieldHeader));
+        build_wall_field(level, fields, queue);
+        if (has_exit) {
+            build_exit_field(level, fields + cells, queue);
+        }
+        free(queue);
+
+        /* A read-only map directory only costs the rebuild next time. */
+        if (!write_file_atomic(cache, block, field_size)) {
+            fprintf(stderr, "[WARN] Could not write field cache '%s'.\n", cache);
+        }
+
+        level->field_base   = block;
+        level->field_size   = field_size;
+        level->field_mapped = 0;
+    }
+
+    const uint16_t *fields = (const uint16_t *)((const unsigned char *)level->field_base +
+                                                sizeof(LevelFieldHeader));
+    level->wall_distance = fields;
+    level->exit_distance = has_exit ? fields + cells : NULL;
+    return 1;
+}
+
+/* ---------------------------------------------------------
+   Public API
+   --------------------------------------------------------- */
+
+size_t level_words_per_row(int width)
+{
+    return ((size_t)width + 63) / 64;
+}
+
+/* Exit cells a game can reach, counted the way level_save() does:
+   inside the map and not under an obstacle. */
+static unsigned long count_exits(const Level *level)
+{
+    const size_t   words    = level->words_per_row;
+    const size_t   plane    = words * (size_t)level->height;
+    const uint64_t row_mask = (level->width % 64) ? ((uint64_t)1 << (level->width % 64)) - 1
+                                                  : ~(uint64_t)0;
+    unsigned long  count    = 0;
+
+    for (size_t i = 0; i < plane; ++i) {
+        uint64_t bits = level->exits[i];
+        if (!bits) {
+            continue;
+        }
+        bits &= ((i % words) == words - 1) ? row_mask : ~(uint64_t)0;
+        for (bits &= ~level->obstacles[i]; bits; bits &= bits - 1) {
+            count++;
+        }
+    }
+    return count;
+}
+
+Level *level_load(const char *path)
+{
+    if (!path) {
+        return NULL;
+    }
+
+    Level *level = (Level *)calloc(1, sizeof(Level));
+    if (!level) {
+        return NULL;
+    }
+
+    level->map_base = map_file(path, &level->map_size);
+    if (!level->map_base) {
+        fprintf(stderr, "[ERROR] Cannot open map '%s'.\n", path);
+        free(level);
+        return NULL;
+    }
+
+    LevelHeader header;
+    if (level->map_size < sizeof(header)) {
+        fprintf(stderr, "[ERROR] Map '%s' is truncated.\n", path);
+        level_destroy(level);
+        return NULL;
+    }
+    memcpy(&header, level->map_base, sizeof(header));
+
+    if (header.magic != LEVEL_MAGIC || header.version != LEVEL_VERSION ||
+        header.width == 0 || header.height == 0 ||
+        header.width > 1000000000u || header.height > 1000000000u) {
+        fprintf(stderr, "[ERROR] '%s' is not a version %u map.\n", path, LEVEL_VERSION);
+        level_destroy(level);
+        return NULL;
+    }
+
+    const size_t   words    = level_words_per_row((int)header.width);
+    const uint64_t plane    = (uint64_t)words * header.height * sizeof(uint64_t);
+    const uint64_t expected = sizeof(LevelHeader) + 2 * plane;
+
+    if (expected != (uint64_t)level->map_size || header.start_x >= header.width ||
+        header.start_y >= header.height) {
+        fprintf(stderr, "[ERROR] Map '%s' does not match its header.\n", path);
+        level_destroy(level);
+        return NULL;
+    }
+
+    const unsigned char *base = (const unsigned char *)level->map_base;
+
+    level->width         = (int)header.width;
+    level->height        = (int)header.height;
+    level->start.x       = (int)header.start_x;
+    level->start.y       = (int)header.start_y;
+    level->food_goal     = header.food_goal;
+    level->exit_count    = header.exit_count;
+    level->words_per_row = words;
+    level->obstacles     = (const uint64_t *)(base + sizeof(LevelHeader));
+    level->exits         = (const uint64_t *)(base + sizeof(LevelHeader) + plane);
+
+    /* The count decides whether an exit field is built, so a header
+       that disagrees with the exit plane would leave exits the bots
+       cannot see. */
+    if (count_exits(level) != level->exit_count) {
+        fprintf(stderr, "[ERROR] Map '%s' does not match its header.\n", path);
+        level_destroy(level);
+        return NULL;
+    }
+
+    if ((size_t)level->width * (size_t)level->height <= LEVEL_FIELD_MAX_CELLS &&
+        !attach_fields(level, path)) {
+        fprintf(stderr, "[ERROR] Out of memory building fields for '%s'.\n", path);
+        level_destroy(level);
+        return NULL;
+    }
+
+    return level;
+}
+
+void level_destroy(Level *level)
+{
+    if (!level) {
+        return;
+    }
+
+    if (level->field_base) {
+        if (level->field_mapped) {
+            unmap_file(level->field_base, level->field_size);
+        } else {
+            free(level->field_base);
+        }
+    }
+    if (level->map_base) {
+        unmap_file(level->map_base, level->map_size);
+    }
+    free(level);
+}
+
+int level_save(const char *path, const LevelDesc *desc)
+{
+    if (!path || !desc || desc->width <= 0 || desc->height <= 0 ||
+        !desc->obstacles || !desc->exits) {
+        return 0;
+    }
+
+    const size_t words = level_words_per_row(desc->width);
+    const size_t plane = words * (size_t)desc->height;
+    const size_t size  = sizeof(LevelHeader) + 2 * plane * sizeof(uint64_t);
+
+    unsigned char *block = (unsigned char *)malloc(size);
+    if (!block) {
+        return 0;
+    }
+
+    uint64_t *obstacles = (uint64_t *)(block + sizeof(LevelHeader));
+    uint64_t *exits     = obstacles + plane;
+    uint64_t  row_mask  = (desc->width % 64) ? ((uint64_t)1 << (desc->width % 64)) - 1
+                                             : ~(uint64_t)0;
+    uint32_t  exit_count = 0;
+
+    /* Padding bits past the last column are cleared so lookups and
+       the exit count never see them. */
+    for (size_t i = 0; i < plane; ++i) {
+        uint64_t mask = ((i % words) == words - 1) ? row_mask : ~(uint64_t)0;
+        obstacles[i]  = desc->obstacles[i] & mask;
+        exits[i]      = desc->exits[i] & mask & ~obstacles[i];
+
+        for (uint64_t bits = exits[i]; bits; bits &= bits - 1) {
+            exit_count++;
+        }
+    }
+
+    LevelHeader header;
+    header.magic      = LEVEL_MAGIC;
+    header.version    = LEVEL_VERSION;
+    header.width      = (uint32_t)desc->width;
+    header.height     = (uint32_t)desc->height;
+    header.start_x    = (uint32_t)desc->start.x;
+    header.start_y    = (uint32_t)desc->start.y;
+    header.food_goal  = (uint32_t)desc->food_goal;
+    header.exit_count = exit_count;
+    memcpy(block, &header, sizeof(header));
+
+    int ok = write_file_atomic(path, block, size);
+    free(block);
+    return ok;
+}
+
+unsigned level_wall_distance(const Level *level, int x, int y)
+{
+    if (!level || !level->wall_distance ||
+        (unsigned)x >= (unsigned)level->width || (unsigned)y >= (unsigned)level->height) {
+        return LEVEL_FIELD_UNREACHABLE;
+    }
+    return level->wall_distance[(size_t)y * (size_t)level->width + (size_t)x];
+}
+
+unsigned level_exit_distance(const Level *level, int x, int y)
+{
+    if (!level || !level->exit_distance ||
+        (unsigned)x >= (unsigned)level->width || (unsigned)y >= (unsigned)level->height) {
+        return LEVEL_FIELD_UNREACHABLE;
+    }
+    return level->exit_distance[(size_t)y * (size_t)level->width + (size_t)x];
+}
@@ -4,7 +4,7 @@
  File:       main.c
  Author:     Mobin Yousefi (GitHub: github.com/mobinyousefi-cs)
  Created:    2025-11-26
- Updated:    2025-11-26
+ Updated:    2026-10-19
  License:    MIT License (see LICENSE file for details)
 ===========================================================
 
@@ -15,78 +15,306 @@
 
  Usage:
     make
-    ./snake_game
+    ./snake_game [--width N] [--height N] [--games N] [--async-output]
+                 [--map PATH] [--stats-file PATH] [--stats-format prom|jsonl]
 
  Notes:
-    - Uses a simple game loop with a fixed tick duration.
+    - The simulation runs at a fixed tick rate; frames are
+      presented through a non-blocking renderer that drops
+      intermediate frames when the terminal falls behind.
+      With --async-output, frames are handed to a writer
+      thread instead and the tick thread never writes.
+    - The loop itself lives in session.c; main only polls the
+      keyboard, pumps the session, and sleeps until the
+      deadline it returns.
     - Input is polled in non-blocking mode so the snake
       continues moving even when no key is pressed.
+    - --map plays a level file (see level.h and tools/mapgen.c)
+      instead of an empty board; --width/--height are ignored.
+    - Boards larger than the viewport in config.h are drawn
+      through a camera that follows the snake's head.
+    - --games 0 plays games back to back until the player
+      quits; metrics are exported every TELEMETRY_EXPORT_MS
+      and after each game when --stats-file is given.
 ===========================================================
 */
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <time.h>
 
 #include "config.h"
 #include "game.h"
 #include "input.h"
+#include "level.h"
+#include "metrics.h"
+#include "render.h"
+#include "session.h"
+#include "telemetry.h"
 #include "utils.h"
 
-int main(void)
+typedef struct Options {
+    int             width;
+    int             height;
+    long            games;
+    int             async_output;
+    const char     *map_path;
+    const char     *stats_path;
+    TelemetryFormat stats_format;
+} Options;
+
+static int parse_arguments(int argc, char **argv, Options *options)
+{
+    for (int i = 1; i < argc; ++i) {
+        const char *name  = argv[i];
+        const char *value = (i + 1 < argc) ? argv[i + 1] : NULL;
+        long        number;
+
+        if (strcmp(name, "--async-output") == 0) {
+            options->async_output = 1;
+            continue;
+        }
+
+        if (!value) {
+            fprintf(stderr, "[ERROR] Option '%s' expects a value.\n", name);
+            return 0;
+        }
+
+        if (strcmp(name, "--width") == 0 || strcmp(name, "--height") == 0) {
+            if (!utils_parse_long(value, 1, &number) || number > 1000000000L) {
+                fprintf(stderr, "[ERROR] Option '%s' expects a positive integer.\n", name);
+                return 0;
+            }
+            if (strcmp(name, "--width") == 0) {
+                options->width = (int)number;
+            } else {
+                options->height = (int)number;
+            }
+        } else if (strcmp(name, "--games") == 0) {
+            if (!utils_parse_long(value, 0, &number) || number > 1000000000L) {
+                fprintf(stderr, "[ERROR] Option '%s' expects a non-negative integer.\n", name);
+                return 0;
+            }
+            options->games = number;
+        } else if (strcmp(name, "--map") == 0) {
+            options->map_path = value;
+        } else if (strcmp(name, "--stats-file") == 0) {
+            options->stats_path = value;
+        } else if (strcmp(name, "--stats-format") == 0) {
+            if (strcmp(value, "prom") == 0) {
+                options->stats_format = TELEMETRY_PROMETHEUS;
+            } else if (strcmp(value, "jsonl") == 0) {
+                options->stats_format = TELEMETRY_JSONL;
+            } else {
+                fprintf(stderr, "[ERROR] Option '%s' expects 'prom' or 'jsonl'.\n", name);
+                return 0;
+            }
+        } else {
+            fprintf(stderr, "[ERROR] Unknown option '%s'.\n", name);
+            return 0;
+        }
+        ++i;
+    }
+
+    return 1;
+}
+
+/* Sleeps until the session's next deadline, waking early when a
+   partly written frame can make progress. */
+static void wait_for_deadline(const GameSession *session, long long deadline_ns)
+{
+    long long now = utils_now_ns();
+    if (now >= deadline_ns) {
+        return;
+    }
+
+    int remaining_ms = (int)((deadline_ns - now + 999999LL) / 1000000LL);
+
+    if (session_wants_output(session)) {
+        utils_wait_stdout_writable(remaining_ms);
+    } else {
+        utils_sleep_ms(remaining_ms);
+    }
+}
+
+static void export_metrics(const Options *options, EngineMetrics *metrics, GameReport *report)
+{
+    if (!options->stats_path) {
+        return;
+    }
+
+    metrics_flush(metrics, report);
+    telemetry_export_file(metrics->registry, options->stats_path, options->stats_format);
+}
+
+static void play_game(GameSession *session, const Options *options,
+                      EngineMetrics *metrics, long long *next_export)
+{
+    const long long          export_ns   = TELEMETRY_EXPORT_MS * 1000000LL;
+    Renderer                *renderer    = session->renderer;
+    const unsigned long long bytes_start = renderer->stats.bytes_written;
+    const unsigned long long drops_start = renderer->stats.frames_dropped;
+
+    for (;;) {
+        session_push_input(session, input_poll());
+
+        long long deadline = session_pump(session, utils_now_ns());
+        if (deadline == SESSION_DONE) {
+            break;
+        }
+
+        long long now = utils_now_ns();
+        if (now >= *next_export) {
+            export_metrics(options, metrics, &session->report);
+            *next_export = now + export_ns;
+        }
+
+        wait_for_deadline(session, deadline);
+    }
+
+    session->report.render_bytes   = renderer->stats.bytes_written - bytes_start;
+    session->report.frames_dropped = renderer->stats.frames_dropped - drops_start;
+}
+
+static void record_game(const Options *options, EngineMetrics *metrics,
+                        unsigned long long index, const Game *game, GameReport *report)
+{
+    metrics_record_game(metrics, game, report);
+
+    if (!options->stats_path) {
+        return;
+    }
+
+    if (options->stats_format == TELEMETRY_JSONL) {
+        FILE *out = fopen(options->stats_path, "a");
+        if (out) {
+            metrics_write_game_jsonl(out, index, game, report);
+            fclose(out);
+        }
+    }
+
+    telemetry_export_file(metrics->registry, options->stats_path, options->stats_format);
+}
+
+int main(int argc, char **argv)
 {
+    Options options;
+    options.width        = BOARD_WIDTH;
+    options.height       = BOARD_HEIGHT;
+    options.games        = 1;
+    options.async_output = 0;
+    options.map_path     = NULL;
+    options.stats_path   = NULL;
+    options.stats_format = TELEMETRY_PROMETHEUS;
+
+    if (!parse_arguments(argc, argv, &options)) {
+        fprintf(stderr, "Usage: %s [--width N] [--height N] [--games N] [--async-output] "
+                        "[--map PATH] [--stats-file PATH] [--stats-format prom|jsonl]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    Level *level = NULL;
+    if (options.map_path) {
+        level = level_load(options.map_path);
+        if (!level) {
+            return EXIT_FAILURE;
+        }
+    }
+
     if (!utils_terminal_init()) {
         fprintf(stderr, "[ERROR] Failed to initialize terminal.\n");
+        level_destroy(level);
         return EXIT_FAILURE;
     }
 
     atexit(utils_terminal_restore);
 
-    Game *game = game_create();
-    if (!game) {
-        fprintf(stderr, "[ERROR] Failed to create game.\n");
+    static TelemetryRegistry registry;
+    EngineMetrics            metrics;
+    telemetry_init(&registry);
+    metrics_init(&metrics, &registry);
+
+    Renderer renderer;
+    int      ready = options.async_output ? renderer_init_async(&renderer)
+                                          : renderer_init(&renderer);
+    if (!ready) {
+        fprintf(stderr, "[ERROR] Failed to create renderer.\n");
+        level_destroy(level);
         return EXIT_FAILURE;
     }
 
     utils_clear_screen();
 
-    while (game->status == GAME_RUNNING) {
-        InputAction action = input_poll();
+    const uint64_t     seed        = (uint64_t)time(NULL);
+    long long          next_export = utils_now_ns() + TELEMETRY_EXPORT_MS * 1000000LL;
+    unsigned long long played      = 0;
+    unsigned long long tick_count  = 0;
+    unsigned long long jitter_sum  = 0;
+    unsigned long long jitter_max  = 0;
+    int                last_score  = 0;
+    GameStatus         last_status = GAME_RUNNING;
 
-        switch (action) {
-        case INPUT_TURN_UP:
-            game_change_direction(game, DIR_UP);
-            break;
-        case INPUT_TURN_DOWN:
-            game_change_direction(game, DIR_DOWN);
-            break;
-        case INPUT_TURN_LEFT:
-            game_change_direction(game, DIR_LEFT);
-            break;
-        case INPUT_TURN_RIGHT:
-            game_change_direction(game, DIR_RIGHT);
-            break;
-        case INPUT_QUIT:
-            game->status = GAME_OVER_QUIT;
-            break;
-        case INPUT_NONE:
-        default:
-            break;
+    while (options.games == 0 || played < (unsigned long long)options.games) {
+        Game *game = level ? game_create_level(level, seed + played)
+                           : game_create_ex(options.width, options.height, seed + played);
+        if (!game) {
+            renderer_free(&renderer);
+            level_destroy(level);
+            fprintf(stderr, "[ERROR] Failed to create game.\n");
+            return EXIT_FAILURE;
+        }
+
+        GameSession session;
+        session_init(&session, game, &renderer, GAME_TICK_MS * 1000000LL, utils_now_ns());
+        if (options.stats_path) {
+            metrics_report_sample(&session.report, METRICS_SAMPLE_EVERY);
         }
 
-        game_update(game);
-        game_render(game);
+        play_game(&session, &options, &metrics, &next_export);
+        record_game(&options, &metrics, played, game, &session.report);
 
-        utils_sleep_ms(GAME_TICK_MS);
+        tick_count += session.report.tick_count;
+        jitter_sum += session.report.tick_jitter_sum;
+        if (session.report.tick_jitter_max > jitter_max) {
+            jitter_max = session.report.tick_jitter_max;
+        }
+
+        played++;
+        last_score  = game->score;
+        last_status = game->status;
+        game_destroy(game);
+
+        if (last_status == GAME_OVER_QUIT) {
+            break;
+        }
     }
 
+    renderer_finish(&renderer, utils_now_ns());
+    renderer_free(&renderer);
+    level_destroy(level);
+
     utils_clear_screen();
 
-    if (game->status == GAME_OVER_COLLISION) {
-        printf("Game Over! Final score: %d\n", game->score);
-    } else if (game->status == GAME_OVER_QUIT) {
-        printf("You quit the game. Final score: %d\n", game->score);
+    if (last_status == GAME_OVER_COLLISION) {
+        printf("Game Over! Final score: %d\n", last_score);
+    } else if (last_status == GAME_OVER_QUIT) {
+        printf("You quit the game. Final score: %d\n", last_score);
+    } else if (last_status == GAME_OVER_EXIT) {
+        printf("Level complete! Final score: %d\n", last_score);
+    }
+
+    if (played > 1) {
+        printf("Games played: %llu, best score: %llu\n", played,
+               atomic_load(&metrics.best_score->value));
     }
 
-    game_destroy(game);
+    printf("Frames: %llu presented, %llu dropped, max render lag %lld ms\n",
+           renderer.stats.frames_presented, renderer.stats.frames_dropped,
+           renderer.stats.max_lag_ns / 1000000LL);
+    printf("Tick jitter: %.3f ms mean, %.3f ms max\n",
+           tick_count ? (double)jitter_sum / (double)tick_count / 1e6 : 0.0,
+           (double)jitter_max / 1e6);
+
     return EXIT_SUCCESS;
 }
@@ -0,0 +1,210 @@
+/*
+===========================================================
+ Project:    Snake Game in Console
+ File:       metrics.c
+ Author:     Mobin Yousefi (GitHub: github.com/mobinyousefi-cs)
+ Created:    2026-10-19
+ Updated:    2026-10-19
+ License:    MIT License (see LICENSE file for details)
+===========================================================
+
+ Description:
+    Registers the engine metric set and publishes finished
+    games into it and into per-game JSONL records.
+===========================================================
+*/
+
+#include "metrics.h"
+
+static void histogram_accumulate(TelemetryHistogram *into, const TelemetryHistogram *from)
+{
+    for (size_t b = 0; b < TELEMETRY_BUCKET_COUNT; ++b) {
+        into->buckets[b] += from->buckets[b];
+    }
+    into->count += from->count;
+    into->sum   += from->sum;
+}
+
+/* Bucket counts of a game's histogram, flushed part plus pending,
+   keyed like the aggregate JSONL export. */
+static void write_game_buckets(FILE *out, const char *name, const TelemetryHistogram *flushed,
+                               const TelemetryHistogram *pending)
+{
+    fprintf(out, ",\"%s\":{", name);
+    for (size_t b = 0; b < TELEMETRY_BUCKET_COUNT; ++b) {
+        unsigned long long n = flushed->buckets[b] + pending->buckets[b];
+        if (b + 1 < TELEMETRY_BUCKET_COUNT) {
+            fprintf(out, "%s\"%llu\":%llu", b ? "," : "",
+                    1ULL << (TELEMETRY_BUCKET_MIN_LOG2 + b), n);
+        } else {
+            fprintf(out, ",\"+Inf\":%llu", n);
+        }
+    }
+    fputc('}', out);
+}
+
+void metrics_init(EngineMetrics *metrics, TelemetryRegistry *registry)
+{
+    if (!metrics) {
+        return;
+    }
+
+    metrics->registry = registry;
+
+    metrics->games = telemetry_register(registry, "snake_games_total",
+                                        "Games finished.", METRIC_COUNTER);
+    metrics->score = telemetry_register(registry, "snake_score_total",
+                                        "Sum of final scores.", METRIC_COUNTER);
+    metrics->best_score = telemetry_register(registry, "snake_best_score",
+                                             "Highest final score seen.", METRIC_GAUGE);
+    metrics->ticks = telemetry_register(registry, "snake_ticks_total",
+                                        "Simulation ticks survived.", METRIC_COUNTER);
+    metrics->food = telemetry_register(registry, "snake_food_eaten_total",
+                                       "Food items eaten.", METRIC_COUNTER);
+    metrics->deaths_wall = telemetry_register(registry, "snake_deaths_total{cause=\"wall\"}",
+                                              "Games ended by a collision, by cause.",
+                                              METRIC_COUNTER);
+    metrics->deaths_self = telemetry_register(registry, "snake_deaths_total{cause=\"self\"}",
+                                              "Games ended by a collision, by cause.",
+                                              METRIC_COUNTER);
+    metrics->quits = telemetry_register(registry, "snake_quits_total",
+                                        "Games ended by the player quitting.", METRIC_COUNTER);
+    metrics->levels_cleared = telemetry_register(registry, "snake_levels_cleared_total",
+                                                 "Games ended by reaching an open exit.",
+                                                 METRIC_COUNTER);
+    metrics->render_bytes = telemetry_register(registry, "snake_render_bytes_total",
+                                               "Bytes of frame output written.", METRIC_COUNTER);
+    metrics->frames_dropped = telemetry_register(registry, "snake_frames_dropped_total",
+                                                 "Frames skipped under output backpressure.",
+                                                 METRIC_COUNTER);
+    metrics->tick_latency = telemetry_register(registry, "snake_tick_latency_seconds",
+                                               "Time spent on input, update, and render per tick.",
+                                               METRIC_HISTOGRAM);
+    metrics->tick_jitter = telemetry_register(registry, "snake_tick_jitter_seconds",
+                                              "Delay between a tick's deadline and its start.",
+                                              METRIC_HISTOGRAM);
+}
+
+void metrics_report_reset(GameReport *report)
+{
+    if (!report) {
+        return;
+    }
+
+    telemetry_histogram_reset(&report->pending_latency);
+    telemetry_histogram_reset(&report->pending_jitter);
+    telemetry_histogram_reset(&report->game_latency);
+    telemetry_histogram_reset(&report->game_jitter);
+    report->tick_latency_sum = 0;
+    report->tick_latency_max = 0;
+    report->tick_jitter_sum  = 0;
+    report->tick_jitter_max  = 0;
+    report->tick_count       = 0;
+    report->tick_samples     = 0;
+    report->render_bytes     = 0;
+    report->frames_dropped   = 0;
+    report->sample_every     = 0;
+    report->sample_countdown = 0;
+}
+
+/* Times one tick in every, starting with the next; 0 stops timing. */
+void metrics_report_sample(GameReport *report, unsigned int every)
+{
+    if (!report) {
+        return;
+    }
+
+    report->sample_every     = every;
+    report->sample_countdown = 1;
+}
+
+void metrics_observe_tick(GameReport *report, unsigned long long latency_ns,
+                          unsigned long long jitter_ns)
+{
+    telemetry_histogram_observe(&report->pending_latency, latency_ns);
+    telemetry_histogram_observe(&report->pending_jitter, jitter_ns);
+    report->tick_latency_sum += latency_ns;
+    report->tick_samples++;
+    if (latency_ns > report->tick_latency_max) {
+        report->tick_latency_max = latency_ns;
+    }
+}
+
+void metrics_flush(EngineMetrics *metrics, GameReport *report)
+{
+    if (!metrics || !report) {
+        return;
+    }
+
+    telemetry_merge(metrics->tick_latency, &report->pending_latency);
+    telemetry_merge(metrics->tick_jitter, &report->pending_jitter);
+    histogram_accumulate(&report->game_latency, &report->pending_latency);
+    histogram_accumulate(&report->game_jitter, &report->pending_jitter);
+    telemetry_histogram_reset(&report->pending_latency);
+    telemetry_histogram_reset(&report->pending_jitter);
+}
+
+void metrics_record_game(EngineMetrics *metrics, const Game *game, GameReport *report)
+{
+    if (!metrics || !game) {
+        return;
+    }
+
+    telemetry_add(metrics->games, 1);
+    telemetry_add(metrics->score, (unsigned long long)game->score);
+    telemetry_max(metrics->best_score, (unsigned long long)game->score);
+    telemetry_add(metrics->ticks, game->stats.ticks);
+    telemetry_add(metrics->food, game->stats.food_eaten);
+
+    if (game->stats.death == DEATH_WALL) {
+        telemetry_add(metrics->deaths_wall, 1);
+    } else if (game->stats.death == DEATH_SELF) {
+        telemetry_add(metrics->deaths_self, 1);
+    } else if (game->status == GAME_OVER_QUIT) {
+        telemetry_add(metrics->quits, 1);
+    } else if (game->status == GAME_OVER_EXIT) {
+        telemetry_add(metrics->levels_cleared, 1);
+    }
+
+    if (report) {
+        metrics_flush(metrics, report);
+        telemetry_add(metrics->render_bytes, report->render_bytes);
+        telemetry_add(metrics->frames_dropped, report->frames_dropped);
+    }
+}
+
+int metrics_write_game_jsonl(FILE *out, unsigned long long game_index,
+                             const Game *game, const GameReport *report)
+{
+    if (!out || !game) {
+        return 0;
+    }
+
+    fprintf(out,
+            "{\"type\":\"game\",\"time_ms\":%lld,\"game\":%llu,\"score\":%d,"
+            "\"ticks\":%llu,\"food_eaten\":%lu,\"death\":\"%s\",\"quit\":%s,\"cleared\":%s",
+            telemetry_wall_clock_ms(), game_index, game->score,
+            game->stats.ticks, game->stats.food_eaten,
+            game_death_name(game->stats.death),
+            (game->status == GAME_OVER_QUIT) ? "true" : "false",
+            (game->status == GAME_OVER_EXIT) ? "true" : "false");
+
+    if (report) {
+        fprintf(out, ",\"render_bytes\":%llu,\"frames_dropped\":%llu,"
+                     "\"tick_samples\":%llu,"
+                     "\"tick_latency_mean_ns\":%llu,\"tick_latency_max_ns\":%llu,"
+                     "\"tick_jitter_mean_ns\":%llu,\"tick_jitter_max_ns\":%llu",
+                report->render_bytes, report->frames_dropped, report->tick_samples,
+                report->tick_samples ? report->tick_latency_sum / report->tick_samples : 0ULL,
+                report->tick_latency_max,
+                report->tick_count ? report->tick_jitter_sum / report->tick_count : 0ULL,
+                report->tick_jitter_max);
+        write_game_buckets(out, "tick_latency_buckets_le_ns", &report->game_latency,
+                           &report->pending_latency);
+        write_game_buckets(out, "tick_jitter_buckets_le_ns", &report->game_jitter,
+                           &report->pending_jitter);
+    }
+
+    fputs("}\n", out);
+    return !ferror(out);
+}
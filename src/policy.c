@@ -0,0 +1,476 @@
+/*
+===========================================================
+ Project:    Snake Game in Console
+ File:       policy.c
+ Author:     Mobin Yousefi (GitHub: github.com/mobinyousefi-cs)
+ Created:    2026-10-19
+ Updated:    2026-10-19
+ License:    MIT License (see LICENSE file for details)
+===========================================================
+
+ Description:
+    Implementation of the built-in steering policies and the
+    windowed flood fill and breadth-first search they share.
+===========================================================
+*/
+
+#include "policy.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "utils.h"
+
+#define WINDOW_CELLS  (POLICY_WINDOW * POLICY_WINDOW)
+
+/* Hosts often seed a game and its bot with the same value; the
+   policy's stream is offset so it never replays the board's. */
+#define POLICY_SEED_STREAM  0xD1B54A32D192ED03ULL
+
+typedef struct Window {
+    int x0;
+    int y0;
+    int width;
+    int height;
+} Window;
+
+static const char *const g_policy_names[POLICY_COUNT] = {
+    "random",
+    "greedy",
+    "autopilot",
+    "search"
+};
+
+/* Scratch space is only needed by the searching policies, so it is
+   allocated on first use rather than for every bot. */
+static int ensure_scratch(Policy *policy)
+{
+    if (policy->stamp) {
+        return 1;
+    }
+
+    policy->stamp      = (unsigned int *)calloc(WINDOW_CELLS, sizeof(unsigned int));
+    policy->queue      = (int *)malloc(WINDOW_CELLS * sizeof(int));
+    policy->first_move = (unsigned char *)malloc(WINDOW_CELLS);
+
+    if (!policy->stamp || !policy->queue || !policy->first_move) {
+        free(policy->stamp);
+        free(policy->queue);
+        free(policy->first_move);
+        policy->stamp      = NULL;
+        policy->queue      = NULL;
+        policy->first_move = NULL;
+        return 0;
+    }
+
+    return 1;
+}
+
+static unsigned int next_epoch(Policy *policy)
+{
+    if (++policy->epoch == 0) {
+        memset(policy->stamp, 0, WINDOW_CELLS * sizeof(unsigned int));
+        policy->epoch = 1;
+    }
+    return policy->epoch;
+}
+
+static Window window_around(const Board *board, Position center)
+{
+    Window window;
+    window.width  = (board->width < POLICY_WINDOW) ? board->width : POLICY_WINDOW;
+    window.height = (board->height < POLICY_WINDOW) ? board->height : POLICY_WINDOW;
+    window.x0     = utils_clamp_origin(center.x, window.width, board->width);
+    window.y0     = utils_clamp_origin(center.y, window.height, board->height);
+    return window;
+}
+
+static int window_index(const Window *window, int x, int y)
+{
+    int wx = x - window->x0;
+    int wy = y - window->y0;
+
+    if ((unsigned)wx >= (unsigned)window->width || (unsigned)wy >= (unsigned)window->height) {
+        return -1;
+    }
+    return wy * window->width + wx;
+}
+
+static int manhattan(Position a, Position b)
+{
+    return abs(a.x - b.x) + abs(a.y - b.y);
+}
+
+static int is_open_exit(const Game *game, Position cell)
+{
+    return board_cell_at(game->board, cell.x, cell.y) == CELL_EXIT && game_exits_open(game);
+}
+
+/* Directions that do not reverse the snake and lead to a free cell
+   or an open exit. */
+static int candidate_moves(const Game *game, Direction out[4])
+{
+    const Position head  = game->snake->head->pos;
+    const int      exits = game_exits_open(game);
+    int            count = 0;
+
+    for (int d = 0; d < 4; ++d) {
+        if ((Direction)d == SNAKE_DIR_OPPOSITE[game->snake->dir]) {
+            continue;
+        }
+
+        CellKind cell = board_cell_at(game->board, head.x + SNAKE_DIR_DX[d],
+                                      head.y + SNAKE_DIR_DY[d]);
+        if (cell == CELL_EMPTY || (cell == CELL_EXIT && exits)) {
+            out[count++] = (Direction)d;
+        }
+    }
+
+    return count;
+}
+
+/* Distance to the current goal: the food, or once the level's exits
+   are open, the nearest exit read from the precomputed field, which
+   already routes around obstacles. */
+static int goal_distance(const Game *game, Position cell)
+{
+    if (game_exits_open(game) && game->level->exit_distance) {
+        return (int)level_exit_distance(game->level, cell.x, cell.y);
+    }
+    return manhattan(cell, game->board->food);
+}
+
+/* Counts free cells reachable from (x, y), stopping at `cap`.
+   Open cells just past the window edge are assumed to lead to
+   plenty of room, so touching one returns `cap` at once. */
+static int flood_area(Policy *policy, const Board *board, const Window *window,
+                      int x, int y, int cap)
+{
+    const unsigned int epoch = next_epoch(policy);
+
+    int start = window_index(window, x, y);
+    if (start < 0) {
+        return cap;
+    }
+
+    int head = 0;
+    int tail = 0;
+
+    policy->stamp[start]  = epoch;
+    policy->queue[tail++] = start;
+
+    while (head < tail && head < cap) {
+        int cell = policy->queue[head++];
+        int cx   = window->x0 + cell % window->width;
+        int cy   = window->y0 + cell / window->width;
+
+        for (int d = 0; d < 4; ++d) {
+            int nx = cx + SNAKE_DIR_DX[d];
+            int ny = cy + SNAKE_DIR_DY[d];
+
+            if (board_cell_at(board, nx, ny) != CELL_EMPTY) {
+                continue;
+            }
+
+            int next = window_index(window, nx, ny);
+            if (next < 0) {
+                return cap;
+            }
+            if (policy->stamp[next] != epoch) {
+                policy->stamp[next]   = epoch;
+                policy->queue[tail++] = next;
+            }
+        }
+    }
+
+    return (head < cap) ? head : cap;
+}
+
+/* Room left after a move: read from the game's reach tracker when
+   enabled, otherwise flooded inside the window. */
+static int move_area(Policy *policy, const Game *game, const Window *window,
+                     Direction dir, int cap)
+{
+    const Position head = game->snake->head->pos;
+
+    if (game->reach) {
+        int area = game_move_area(game, dir);
+        return (area < cap) ? area : cap;
+    }
+    return flood_area(policy, game->board, window, head.x + SNAKE_DIR_DX[dir],
+                      head.y + SNAKE_DIR_DY[dir], cap);
+}
+
+static int area_needed(const Game *game)
+{
+    int need = game->snake->length * 2 + 8;
+    return (need < WINDOW_CELLS) ? need : WINDOW_CELLS;
+}
+
+/* Shortest path inside the window from the candidate moves to the
+   food (target >= 0) or, with target < 0, to the nearest open exit.
+   Returns the path's first move, or -1 if no goal is in reach. */
+static int window_search(Policy *policy, const Game *game, const Window *window,
+                         const Direction *moves, int count, int target)
+{
+    const Board       *board      = game->board;
+    const Position     head       = game->snake->head->pos;
+    const unsigned int epoch      = next_epoch(policy);
+    int                head_index = 0;
+    int                tail_index = 0;
+
+    for (int i = 0; i < count; ++i) {
+        int cell = window_index(window, head.x + SNAKE_DIR_DX[moves[i]],
+                                head.y + SNAKE_DIR_DY[moves[i]]);
+        if (cell >= 0 && policy->stamp[cell] != epoch) {
+            policy->stamp[cell]         = epoch;
+            policy->first_move[cell]    = (unsigned char)moves[i];
+            policy->queue[tail_index++] = cell;
+        }
+    }
+
+    while (head_index < tail_index) {
+        int cell = policy->queue[head_index++];
+        int cx   = window->x0 + cell % window->width;
+        int cy   = window->y0 + cell / window->width;
+
+        if (cell == target || (target < 0 && board_cell_at(board, cx, cy) == CELL_EXIT)) {
+            return policy->first_move[cell];
+        }
+
+        for (int d = 0; d < 4; ++d) {
+            int      nx   = cx + SNAKE_DIR_DX[d];
+            int      ny   = cy + SNAKE_DIR_DY[d];
+            int      next = window_index(window, nx, ny);
+            CellKind kind = board_cell_at(board, nx, ny);
+
+            if (next < 0 || policy->stamp[next] == epoch ||
+                !(kind == CELL_EMPTY || (target < 0 && kind == CELL_EXIT))) {
+                continue;
+            }
+
+            policy->stamp[next]         = epoch;
+            policy->first_move[next]    = policy->first_move[cell];
+            policy->queue[tail_index++] = next;
+        }
+    }
+
+    return -1;
+}
+
+static Direction choose_random(Policy *policy, const Game *game)
+{
+    Direction moves[4];
+    int       count = candidate_moves(game, moves);
+
+    if (count == 0) {
+        return game->snake->dir;
+    }
+    return moves[utils_xorshift(&policy->rng_state) % (uint64_t)count];
+}
+
+static Direction choose_greedy(Policy *policy, const Game *game)
+{
+    Direction moves[4];
+    int       count = candidate_moves(game, moves);
+
+    if (count == 0) {
+        return game->snake->dir;
+    }
+
+    const Position head      = game->snake->head->pos;
+    Direction      best      = moves[0];
+    int            best_dist = -1;
+    int            ties      = 0;
+
+    for (int i = 0; i < count; ++i) {
+        Position next = { head.x + SNAKE_DIR_DX[moves[i]], head.y + SNAKE_DIR_DY[moves[i]] };
+        int      dist = goal_distance(game, next);
+
+        if (best_dist < 0 || dist < best_dist) {
+            best      = moves[i];
+            best_dist = dist;
+            ties      = 1;
+        } else if (dist == best_dist && utils_xorshift(&policy->rng_state) % (uint64_t)++ties == 0) {
+            best = moves[i];
+        }
+    }
+
+    return best;
+}
+
+/* Greedy toward the goal, but only among moves that leave enough
+   reachable room; otherwise heads for the largest open area. On a
+   level, ties go to the move farther from obstacles. */
+static Direction choose_autopilot(Policy *policy, const Game *game)
+{
+    Direction moves[4];
+    int       count = candidate_moves(game, moves);
+
+    if (count == 0) {
+        return game->snake->dir;
+    }
+
+    const Position head   = game->snake->head->pos;
+    const Window   window = window_around(game->board, head);
+    const int      need   = area_needed(game);
+
+    /* Maps too large for an exit field steer by a windowed search
+       for the nearest exit instead. */
+    int toward = -1;
+    if (game_exits_open(game) && !game->level->exit_distance) {
+        toward = window_search(policy, game, &window, moves, count, -1);
+    }
+
+    Direction best       = moves[0];
+    int       best_roomy = -1;
+    int       best_area  = -1;
+    int       best_dist  = 0;
+    unsigned  best_wall  = 0;
+
+    for (int i = 0; i < count; ++i) {
+        Position next = { head.x + SNAKE_DIR_DX[moves[i]], head.y + SNAKE_DIR_DY[moves[i]] };
+        if (is_open_exit(game, next)) {
+            return moves[i];
+        }
+
+        int      area  = move_area(policy, game, &window, moves[i], need);
+        int      roomy = (area >= need);
+        int      dist  = (toward >= 0) ? (moves[i] != (Direction)toward)
+                                       : goal_distance(game, next);
+        unsigned wall  = level_wall_distance(game->level, next.x, next.y);
+
+        int better;
+        if (roomy != best_roomy) {
+            better = roomy > best_roomy;
+        } else if (roomy && dist != best_dist) {
+            better = dist < best_dist;
+        } else if (!roomy && area != best_area) {
+            better = area > best_area;
+        } else {
+            better = wall > best_wall;
+        }
+
+        if (better) {
+            best       = moves[i];
+            best_roomy = roomy;
+            best_area  = area;
+            best_dist  = dist;
+            best_wall  = wall;
+        }
+    }
+
+    return best;
+}
+
+/* Shortest path to the goal inside the window, accepted only if the
+   first step keeps enough room; otherwise defers to autopilot. */
+static Direction choose_search(Policy *policy, const Game *game)
+{
+    const Board   *board     = game->board;
+    const Position head      = game->snake->head->pos;
+    const Window   window    = window_around(board, head);
+    const int      seek_exit = game_exits_open(game);
+    const int      target    = seek_exit ? -1
+                                         : window_index(&window, board->food.x, board->food.y);
+
+    /* Once exits are open the exit field, where the map has one,
+       already is the search. */
+    if (seek_exit ? game->level->exit_distance != NULL : target < 0) {
+        return choose_autopilot(policy, game);
+    }
+
+    Direction moves[4];
+    int       count = candidate_moves(game, moves);
+    if (count == 0) {
+        return game->snake->dir;
+    }
+
+    int found = window_search(policy, game, &window, moves, count, target);
+    if (found < 0) {
+        return choose_autopilot(policy, game);
+    }
+
+    Direction dir  = (Direction)found;
+    int       area = move_area(policy, game, &window, dir, area_needed(game));
+
+    return (area >= area_needed(game)) ? dir : choose_autopilot(policy, game);
+}
+
+Policy *policy_create(PolicyKind kind, uint64_t seed)
+{
+    if ((unsigned)kind >= POLICY_COUNT) {
+        return NULL;
+    }
+
+    Policy *policy = (Policy *)malloc(sizeof(Policy));
+    if (!policy) {
+        return NULL;
+    }
+
+    policy->kind       = kind;
+    policy->rng_state  = utils_splitmix64(seed ^ POLICY_SEED_STREAM);
+    policy->epoch      = 0;
+    policy->stamp      = NULL;
+    policy->queue      = NULL;
+    policy->first_move = NULL;
+
+    return policy;
+}
+
+void policy_destroy(Policy *policy)
+{
+    if (!policy) {
+        return;
+    }
+
+    free(policy->stamp);
+    free(policy->queue);
+    free(policy->first_move);
+    free(policy);
+}
+
+Direction policy_choose(Policy *policy, const Game *game)
+{
+    if (!policy || !game) {
+        return DIR_RIGHT;
+    }
+
+    if ((policy->kind == POLICY_AUTOPILOT || policy->kind == POLICY_SEARCH) &&
+        !ensure_scratch(policy)) {
+        return choose_greedy(policy, game);
+    }
+
+    switch (policy->kind) {
+    case POLICY_GREEDY:
+        return choose_greedy(policy, game);
+    case POLICY_AUTOPILOT:
+        return choose_autopilot(policy, game);
+    case POLICY_SEARCH:
+        return choose_search(policy, game);
+    case POLICY_RANDOM:
+    default:
+        return choose_random(policy, game);
+    }
+}
+
+const char *policy_name(PolicyKind kind)
+{
+    return ((unsigned)kind < POLICY_COUNT) ? g_policy_names[kind] : "unknown";
+}
+
+int policy_from_name(const char *name, PolicyKind *kind)
+{
+    if (!name || !kind) {
+        return 0;
+    }
+
+    for (int i = 0; i < POLICY_COUNT; ++i) {
+        if (strcmp(name, g_policy_names[i]) == 0) {
+            *kind = (PolicyKind)i;
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,367 @@
+/*
+===========================================================
+ Project:    Snake Game in Console
+ File:       pool.c
+ Author:     Mobin Yousefi (GitHub: github.com/mobinyousefi-cs)
+ Created:    2026-10-19
+ Updated:    2026-10-19
+ License:    MIT License (see LICENSE file for details)
+===========================================================
+
+ Description:
+    Implements the work-stealing pool: Chase-Lev deques with
+    C11 atomics (after Le et al., "Correct and Efficient
+    Work-Stealing for Weak Memory Models"), and persistent
+    pthread workers that are woken once per batch.
+===========================================================
+*/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "pool.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "utils.h"
+
+typedef struct Deque {
+    atomic_llong   top;
+    atomic_llong   bottom;
+    atomic_size_t *buffer;
+    long long      mask;
+} Deque;
+
+typedef struct Worker {
+    WorkPool        *pool;
+    int              id;
+    pthread_t        thread;
+    Deque            deque;
+    uint64_t         rng_state;
+    PoolWorkerStats  stats;
+} Worker;
+
+struct WorkPool {
+    Worker         *workers;
+    int             count;
+    int             started;
+    size_t          capacity;
+
+    pthread_mutex_t lock;
+    pthread_cond_t  start_cond;
+    pthread_cond_t  done_cond;
+    unsigned long   generation;
+    int             running;
+    int             shutdown;
+
+    PoolTaskFn      fn;
+    void           *context;
+    PoolSchedule    schedule;
+    atomic_size_t   remaining;
+};
+
+static void deque_push(Deque *deque, size_t task)
+{
+    long long b = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+    atomic_store_explicit(&deque->buffer[b & deque->mask], task, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&deque->bottom, b + 1, memory_order_relaxed);
+}
+
+static int deque_take(Deque *deque, size_t *task)
+{
+    long long b = atomic_load_explicit(&deque->bottom, memory_order_relaxed) - 1;
+    atomic_store_explicit(&deque->bottom, b, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    long long t = atomic_load_explicit(&deque->top, memory_order_relaxed);
+
+    if (t > b) {
+        atomic_store_explicit(&deque->bottom, b + 1, memory_order_relaxed);
+        return 0;
+    }
+
+    *task = atomic_load_explicit(&deque->buffer[b & deque->mask], memory_order_relaxed);
+    if (t < b) {
+        return 1;
+    }
+
+    /* Last element: race the thieves for it. */
+    int won = atomic_compare_exchange_strong_explicit(&deque->top, &t, t + 1,
+                                                      memory_order_seq_cst,
+                                                      memory_order_relaxed);
+    atomic_store_explicit(&deque->bottom, b + 1, memory_order_relaxed);
+    return won;
+}
+
+static int deque_steal(Deque *deque, size_t *task)
+{
+    long long t = atomic_load_explicit(&deque->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    long long b = atomic_load_explicit(&deque->bottom, memory_order_acquire);
+
+    if (t >= b) {
+        return 0;
+    }
+
+    *task = atomic_load_explicit(&deque->buffer[t & deque->mask], memory_order_relaxed);
+    return atomic_compare_exchange_strong_explicit(&deque->top, &t, t + 1,
+                                                   memory_order_seq_cst,
+                                                   memory_order_relaxed);
+}
+
+static int steal_any(Worker *worker, size_t *task)
+{
+    WorkPool *pool  = worker->pool;
+    int       start = (int)(utils_xorshift(&worker->rng_state) % (uint64_t)pool->count);
+
+    for (int i = 0; i < pool->count; ++i) {
+        int victim = (start + i) % pool->count;
+        if (victim != worker->id && deque_steal(&pool->workers[victim].deque, task)) {
+            worker->stats.steals++;
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/* Tasks never spawn tasks, so once every deque is drained the only
+   work left is already running on some worker. */
+static int deques_drained(const WorkPool *pool)
+{
+    for (int i = 0; i < pool->count; ++i) {
+        const Deque *deque = &pool->workers[i].deque;
+        if (atomic_load_explicit(&deque->top, memory_order_acquire) <
+            atomic_load_explicit(&deque->bottom, memory_order_acquire)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static void run_batch(Worker *worker)
+{
+    WorkPool *pool = worker->pool;
+    size_t    task;
+
+    while (atomic_load_explicit(&pool->remaining, memory_order_acquire) > 0) {
+        if (deque_take(&worker->deque, &task) ||
+            (pool->schedule == POOL_STEAL && steal_any(worker, &task))) {
+            long long start = utils_now_ns();
+            pool->fn(pool->context, task, worker->id);
+            worker->stats.busy_ns += utils_now_ns() - start;
+            worker->stats.tasks++;
+            atomic_fetch_sub_explicit(&pool->remaining, 1, memory_order_acq_rel);
+            continue;
+        }
+
+        /* Park until the next batch rather than spinning behind the
+           slowest games; only a lost steal race is worth retrying. */
+        if (pool->schedule == POOL_STATIC || deques_drained(pool)) {
+            return;
+        }
+        sched_yield();
+    }
+}
+
+static void *worker_main(void *arg)
+{
+    Worker        *worker = (Worker *)arg;
+    WorkPool      *pool   = worker->pool;
+    unsigned long  seen   = 0;
+
+    for (;;) {
+        pthread_mutex_lock(&pool->lock);
+        while (!pool->shutdown && pool->generation == seen) {
+            pthread_cond_wait(&pool->start_cond, &pool->lock);
+        }
+        if (pool->shutdown) {
+            pthread_mutex_unlock(&pool->lock);
+            return NULL;
+        }
+        seen = pool->generation;
+        pthread_mutex_unlock(&pool->lock);
+
+        run_batch(worker);
+
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->running == 0) {
+            pthread_cond_signal(&pool->done_cond);
+        }
+        pthread_mutex_unlock(&pool->lock);
+    }
+}
+
+static int reserve_deques(WorkPool *pool, size_t task_count)
+{
+    if (task_count <= pool->capacity) {
+        return 1;
+    }
+
+    size_t capacity = pool->capacity ? pool->capacity : 64;
+    while (capacity < task_count) {
+        capacity *= 2;
+    }
+
+    for (int i = 0; i < pool->count; ++i) {
+        Deque         *deque  = &pool->workers[i].deque;
+        atomic_size_t *buffer = (atomic_size_t *)realloc(deque->buffer,
+                                                         capacity * sizeof(atomic_size_t));
+        if (!buffer) {
+            return 0;
+        }
+        deque->buffer = buffer;
+        deque->mask   = (long long)capacity - 1;
+    }
+
+    pool->capacity = capacity;
+    return 1;
+}
+
+WorkPool *pool_create(int threads)
+{
+    if (threads <= 0) {
+        return NULL;
+    }
+
+    WorkPool *pool = (WorkPool *)calloc(1, sizeof(WorkPool));
+    if (!pool) {
+        return NULL;
+    }
+
+    pool->workers = (Worker *)calloc((size_t)threads, sizeof(Worker));
+    if (!pool->workers) {
+        free(pool);
+        return NULL;
+    }
+
+    pool->count   = threads;
+    pool->started = 1;
+    atomic_init(&pool->remaining, 0);
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->start_cond, NULL);
+    pthread_cond_init(&pool->done_cond, NULL);
+
+    for (int i = 0; i < threads; ++i) {
+        Worker *worker    = &pool->workers[i];
+        worker->pool      = pool;
+        worker->id        = i;
+        worker->rng_state = utils_splitmix64((uint64_t)i);
+        atomic_init(&worker->deque.top, 0);
+        atomic_init(&worker->deque.bottom, 0);
+    }
+
+    if (!reserve_deques(pool, 64)) {
+        pool_destroy(pool);
+        return NULL;
+    }
+
+    /* Worker 0 is the thread that calls pool_run(). */
+    for (int i = 1; i < threads; ++i) {
+        if (pthread_create(&pool->workers[i].thread, NULL, worker_main, &pool->workers[i]) != 0) {
+            pool_destroy(pool);
+            return NULL;
+        }
+        pool->started = i + 1;
+    }
+
+    return pool;
+}
+
+void pool_destroy(WorkPool *pool)
+{
+    if (!pool) {
+        return;
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    pool->shutdown = 1;
+    pthread_cond_broadcast(&pool->start_cond);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (int i = 1; i < pool->started; ++i) {
+        pthread_join(pool->workers[i].thread, NULL);
+    }
+
+    for (int i = 0; i < pool->count; ++i) {
+        free(pool->workers[i].deque.buffer);
+    }
+
+    pthread_cond_destroy(&pool->done_cond);
+    pthread_cond_destroy(&pool->start_cond);
+    pthread_mutex_destroy(&pool->lock);
+    free(pool->workers);
+    free(pool);
+}
+
+int pool_thread_count(const WorkPool *pool)
+{
+    return pool ? pool->count : 0;
+}
+
+int pool_run(WorkPool *pool, size_t task_count, PoolSchedule schedule,
+             PoolTaskFn fn, void *context)
+{
+    if (!pool || !fn) {
+        return 0;
+    }
+
+    for (int i = 0; i < pool->count; ++i) {
+        memset(&pool->workers[i].stats, 0, sizeof(PoolWorkerStats));
+    }
+
+    if (task_count == 0) {
+        return 1;
+    }
+
+    if (!reserve_deques(pool, task_count)) {
+        return 0;
+    }
+
+    /* Workers are parked, so the deques can be filled from here.
+       Contiguous blocks model the naive static split; stealing then
+       rebalances whatever that split gets wrong. */
+    size_t per_worker = (task_count + (size_t)pool->count - 1) / (size_t)pool->count;
+    for (int i = 0; i < pool->count; ++i) {
+        Deque *deque = &pool->workers[i].deque;
+        atomic_store_explicit(&deque->top, 0, memory_order_relaxed);
+        atomic_store_explicit(&deque->bottom, 0, memory_order_relaxed);
+
+        size_t first = (size_t)i * per_worker;
+        for (size_t task = first; task < first + per_worker && task < task_count; ++task) {
+            deque_push(deque, task);
+        }
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    pool->fn       = fn;
+    pool->context  = context;
+    pool->schedule = schedule;
+    pool->running  = pool->count - 1;
+    atomic_store(&pool->remaining, task_count);
+    pool->generation++;
+    pthread_cond_broadcast(&pool->start_cond);
+    pthread_mutex_unlock(&pool->lock);
+
+    run_batch(&pool->workers[0]);
+
+    pthread_mutex_lock(&pool->lock);
+    while (pool->running > 0) {
+        pthread_cond_wait(&pool->done_cond, &pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+
+    return 1;
+}
+
+const PoolWorkerStats *pool_worker_stats(const WorkPool *pool, int worker)
+{
+    if (!pool || worker < 0 || worker >= pool->count) {
+        return NULL;
+    }
+    return &pool->workers[worker].stats;
+}
@@ -0,0 +1,454 @@
+/*
+===========================================================
+ Project:    Snake Game in Console
+ File:       reach.c
+ Author:     Mobin Yousefi (GitHub: github.com/mobinyousefi-cs)
+ Created:    2026-10-19
+ Updated:    2026-10-19
+ License:    MIT License (see LICENSE file for details)
+===========================================================
+
+ Description:
+    Maintains connected free regions of a dense board under
+    single-cell occupy/release updates: lockstep searches
+    detect splits, small-into-large relabelling handles
+    joins, and move queries read region sizes directly.
+===========================================================
+*/
+
+#include "reach.h"
+
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NO_CELL     (-1)
+#define DONE_GROUP  (-1)
+
+static int new_label(ReachTracker *tracker)
+{
+    if (tracker->free_count > 0) {
+        return tracker->free_labels[--tracker->free_count];
+    }
+    return tracker->label_count++;
+}
+
+static void drop_label(ReachTracker *tracker, int label)
+{
+    tracker->size[label]                        = 0;
+    tracker->free_labels[tracker->free_count++] = label;
+}
+
+/* Each split uses four consecutive marks, one per search, so a
+   stale mark from an earlier split never looks current. */
+static unsigned int next_marks(ReachTracker *tracker)
+{
+    if (tracker->epoch > UINT_MAX - 8) {
+        const Board *board  = tracker->board;
+        size_t       padded = (size_t)board->stride * (size_t)(board->height + 2);
+        memset(tracker->seen, 0, padded * sizeof(unsigned int));
+        tracker->epoch = 1;
+    }
+
+    unsigned int base = tracker->epoch;
+    tracker->epoch += 4;
+    return base;
+}
+
+static void search_start(ReachTracker *tracker, ReachSearch *search, int cell, int group)
+{
+    tracker->link[cell] = NO_CELL;
+    search->first       = cell;
+    search->next        = cell;
+    search->last        = cell;
+    search->count       = 1;
+    search->group       = group;
+}
+
+static void search_push(ReachTracker *tracker, ReachSearch *search, int cell)
+{
+    tracker->link[cell]         = NO_CELL;
+    tracker->link[search->last] = cell;
+    search->last                = cell;
+    search->count++;
+    if (search->next == NO_CELL) {
+        search->next = cell;
+    }
+}
+
+static int search_pop(const ReachTracker *tracker, ReachSearch *search)
+{
+    int cell     = search->next;
+    search->next = tracker->link[cell];
+    return cell;
+}
+
+/* Relabels the free cells connected to `start` that carry label
+   `from` (REACH_NO_REGION while rebuilding) and returns their count. */
+static int flood_label(ReachTracker *tracker, int start, int from, int to)
+{
+    const Board *board  = tracker->board;
+    ReachSearch *search = &tracker->searches[0];
+
+    tracker->label[start] = to;
+    search_start(tracker, search, start, 0);
+
+    while (search->next != NO_CELL) {
+        int cell = search_pop(tracker, search);
+
+        for (int d = 0; d < 4; ++d) {
+            int neighbour = cell + board->step[d];
+            if (board->cells[neighbour] == CELL_EMPTY && tracker->label[neighbour] == from) {
+                tracker->label[neighbour] = to;
+                search_push(tracker, search, neighbour);
+            }
+        }
+    }
+
+    return search->count;
+}
+
+static int find_group(const ReachTracker *tracker, int k)
+{
+    while (tracker->searches[k].group != k) {
+        k = tracker->searches[k].group;
+    }
+    return k;
+}
+
+static int group_pending(const ReachTracker *tracker, int count, int group)
+{
+    for (int j = 0; j < count; ++j) {
+        const ReachSearch *search = &tracker->searches[j];
+        if (search->group != DONE_GROUP && search->next != NO_CELL &&
+            find_group(tracker, j) == group) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/* A group whose searches all ran dry without meeting the others
+   has seen exactly one detached part of the region. */
+static void detach_group(ReachTracker *tracker, int region, int count, int group)
+{
+    const int label   = new_label(tracker);
+    int       members = 0;
+    int       total   = 0;
+
+    for (int j = 0; j < count; ++j) {
+        const ReachSearch *search = &tracker->searches[j];
+        if (search->group == DONE_GROUP || find_group(tracker, j) != group) {
+            continue;
+        }
+
+        members |= 1 << j;
+        total   += search->count;
+        for (int cell = search->first; cell != NO_CELL; cell = tracker->link[cell]) {
+            tracker->label[cell] = label;
+        }
+    }
+
+    for (int j = 0; j < count; ++j) {
+        if (members & (1 << j)) {
+            tracker->searches[j].group = DONE_GROUP;
+        }
+    }
+
+    tracker->size[label]   = total;
+    tracker->size[region] -= total;
+    tracker->splits++;
+}
+
+/* Runs one search per free neighbour of the removed cell, taking
+   one expansion from each in turn, until at most one group is
+   still open. The open group keeps the region's label. */
+static void split_region(ReachTracker *tracker, int region, int count)
+{
+    const Board       *board  = tracker->board;
+    const unsigned int base   = next_marks(tracker);
+    int                groups = count;
+
+    for (int k = 0; k < count; ++k) {
+        tracker->seen[tracker->searches[k].first] = base + (unsigned int)k;
+    }
+
+    while (groups > 1) {
+        for (int k = 0; k < count && groups > 1; ++k) {
+            ReachSearch *search = &tracker->searches[k];
+            if (search->group == DONE_GROUP) {
+                continue;
+            }
+
+            if (search->next == NO_CELL) {
+                int group = find_group(tracker, k);
+                if (!group_pending(tracker, count, group)) {
+                    detach_group(tracker, region, count, group);
+                    groups--;
+                }
+                continue;
+            }
+
+            int cell = search_pop(tracker, search);
+            tracker->cells_searched++;
+
+            for (int d = 0; d < 4; ++d) {
+                int neighbour = cell + board->step[d];
+                if (board->cells[neighbour] != CELL_EMPTY || tracker->label[neighbour] != region) {
+                    continue;
+                }
+
+                unsigned int owner = tracker->seen[neighbour] - base;
+                if (owner < (unsigned int)count) {
+                    int a = find_group(tracker, k);
+                    int b = find_group(tracker, (int)owner);
+                    if (a != b) {
+                        tracker->searches[b].group = a;
+                        groups--;
+                    }
+                } else {
+                    tracker->seen[neighbour] = base + (unsigned int)k;
+                    search_push(tracker, search, neighbour);
+                }
+            }
+        }
+    }
+}
+
+ReachTracker *reach_create(const Board *board)
+{
+    if (!board || !board->cells) {
+        return NULL;
+    }
+
+    ReachTracker *tracker = (ReachTracker *)calloc(1, sizeof(ReachTracker));
+    if (!tracker) {
+        return NULL;
+    }
+
+    const size_t padded = (size_t)board->stride * (size_t)(board->height + 2);
+    const size_t cells  = (size_t)board->width * (size_t)board->height;
+
+    tracker->board       = board;
+    tracker->label       = (int *)malloc(padded * sizeof(int));
+    tracker->link        = (int *)malloc(padded * sizeof(int));
+    tracker->seen        = (unsigned int *)calloc(padded, sizeof(unsigned int));
+    tracker->size        = (int *)malloc(cells * sizeof(int));
+    tracker->free_labels = (int *)malloc(cells * sizeof(int));
+    tracker->epoch       = 1;
+
+    if (!tracker->label || !tracker->link || !tracker->seen || !tracker->size ||
+        !tracker->free_labels || !reach_rebuild(tracker)) {
+        reach_destroy(tracker);
+        return NULL;
+    }
+
+    return tracker;
+}
+
+void reach_destroy(ReachTracker *tracker)
+{
+    if (!tracker) {
+        return;
+    }
+
+    free(tracker->label);
+    free(tracker->link);
+    free(tracker->seen);
+    free(tracker->size);
+    free(tracker->free_labels);
+    free(tracker);
+}
+
+int reach_rebuild(ReachTracker *tracker)
+{
+    if (!tracker) {
+        return 0;
+    }
+
+    const Board *board  = tracker->board;
+    const size_t padded = (size_t)board->stride * (size_t)(board->height + 2);
+
+    for (size_t i = 0; i < padded; ++i) {
+        tracker->label[i] = REACH_NO_REGION;
+    }
+    tracker->label_count = 0;
+    tracker->free_count  = 0;
+
+    for (int y = 0; y < board->height; ++y) {
+        for (int x = 0; x < board->width; ++x) {
+            int cell = board_cell_index(board, x, y);
+            if (board->cells[cell] == CELL_EMPTY && tracker->label[cell] == REACH_NO_REGION) {
+                int label = new_label(tracker);
+                tracker->size[label] = flood_label(tracker, cell, REACH_NO_REGION, label);
+            }
+        }
+    }
+
+    return 1;
+}
+
+void reach_occupy(ReachTracker *tracker, int x, int y)
+{
+    if (!tracker) {
+        return;
+    }
+
+    const Board *board  = tracker->board;
+    const int    cell   = board_cell_index(board, x, y);
+    const int    region = tracker->label[cell];
+
+    if (region == REACH_NO_REGION) {
+        return;
+    }
+
+    tracker->label[cell] = REACH_NO_REGION;
+    if (--tracker->size[region] == 0) {
+        drop_label(tracker, region);
+        return;
+    }
+
+    int count = 0;
+    for (int d = 0; d < 4; ++d) {
+        int neighbour = cell + board->step[d];
+        if (board->cells[neighbour] == CELL_EMPTY && tracker->label[neighbour] == region) {
+            search_start(tracker, &tracker->searches[count], neighbour, count);
+            count++;
+        }
+    }
+
+    if (count > 1) {
+        split_region(tracker, region, count);
+    }
+}
+
+void reach_release(ReachTracker *tracker, int x, int y)
+{
+    if (!tracker) {
+        return;
+    }
+
+    const Board *board = tracker->board;
+    const int    cell  = board_cell_index(board, x, y);
+
+    if (board->cells[cell] != CELL_EMPTY || tracker->label[cell] != REACH_NO_REGION) {
+        return;
+    }
+
+    int labels[4];
+    int starts[4];
+    int count = 0;
+    int best  = 0;
+
+    for (int d = 0; d < 4; ++d) {
+        int neighbour = cell + board->step[d];
+        int label     = tracker->label[neighbour];
+        int known     = 0;
+
+        if (board->cells[neighbour] != CELL_EMPTY || label == REACH_NO_REGION) {
+            continue;
+        }
+        for (int i = 0; i < count; ++i) {
+            known |= (labels[i] == label);
+        }
+        if (!known) {
+            if (count > 0 && tracker->size[label] > tracker->size[labels[best]]) {
+                best = count;
+            }
+            labels[count]   = label;
+            starts[count++] = neighbour;
+        }
+    }
+
+    if (count == 0) {
+        int label            = new_label(tracker);
+        tracker->label[cell] = label;
+        tracker->size[label] = 1;
+        return;
+    }
+
+    const int keep = labels[best];
+    for (int i = 0; i < count; ++i) {
+        if (i != best) {
+            flood_label(tracker, starts[i], labels[i], keep);
+            tracker->size[keep] += tracker->size[labels[i]];
+            drop_label(tracker, labels[i]);
+        }
+    }
+
+    tracker->label[cell] = keep;
+    tracker->size[keep]++;
+}
+
+int reach_region_size(const ReachTracker *tracker, int x, int y)
+{
+    if (!tracker || !board_is_inside(tracker->board, x, y)) {
+        return 0;
+    }
+
+    int label = tracker->label[board_cell_index(tracker->board, x, y)];
+    return (label == REACH_NO_REGION) ? 0 : tracker->size[label];
+}
+
+/* Free cells reachable from the head after moving in `dir`. Every
+   part the new head cell may cut its region into still touches the
+   head, so that is the region's size less one. Unless the move eats,
+   the tail cell is freed too; it counts, together with any regions
+   it bridges, when it touches the head or that region. */
+int reach_move_area(const ReachTracker *tracker, const Snake *snake,
+                    Position food, Direction dir)
+{
+    if (!tracker || !snake || (unsigned)dir > DIR_RIGHT) {
+        return 0;
+    }
+
+    const Board   *board = tracker->board;
+    const Position head  = snake->head->pos;
+    const int      cell  = board_cell_index(board, head.x, head.y) + board->step[dir];
+
+    if (board->cells[cell] != CELL_EMPTY) {
+        return 0;
+    }
+
+    const int region = tracker->label[cell];
+    const int area   = tracker->size[region] - 1;
+
+    if (head.x + SNAKE_DIR_DX[dir] == food.x && head.y + SNAKE_DIR_DY[dir] == food.y) {
+        return area;
+    }
+
+    const Position tail      = snake->tail->pos;
+    const int      tail_cell = board_cell_index(board, tail.x, tail.y);
+    int            joins     = 0;
+    int            others[4];
+    int            count     = 0;
+    int            bridged   = 0;
+
+    for (int d = 0; d < 4; ++d) {
+        int neighbour = tail_cell + board->step[d];
+        if (neighbour == cell) {
+            joins = 1;
+            continue;
+        }
+        if (board->cells[neighbour] != CELL_EMPTY) {
+            continue;
+        }
+
+        int label = tracker->label[neighbour];
+        if (label == region) {
+            joins = 1;
+            continue;
+        }
+
+        int known = 0;
+        for (int i = 0; i < count; ++i) {
+            known |= (others[i] == label);
+        }
+        if (!known) {
+            others[count++] = label;
+            bridged        += tracker->size[label];
+        }
+    }
+
+    return joins ? area + 1 + bridged : area;
+}
@@ -0,0 +1,207 @@
+/*
+===========================================================
+ Project:    Snake Game in Console
+ File:       render.c
+ Author:     Mobin Yousefi (GitHub: github.com/mobinyousefi-cs)
+ Created:    2026-10-19
+ Updated:    2026-10-19
+ License:    MIT License (see LICENSE file for details)
+===========================================================
+
+ Description:
+    Implements adaptive frame presentation: partial writes
+    are resumed on later ticks, frames that could not start
+    in time are dropped, and presentation lag is tracked.
+    In async mode frames go to the writer thread instead.
+===========================================================
+*/
+
+#include "render.h"
+
+#include <stdlib.h>
+
+#include "utils.h"
+
+#define FRAME_INITIAL_CAPACITY  4096
+
+static int init_common(Renderer *renderer)
+{
+    if (!renderer || !frame_init(&renderer->frame, FRAME_INITIAL_CAPACITY)) {
+        return 0;
+    }
+
+    renderer->written       = 0;
+    renderer->pending       = 0;
+    renderer->frame_time_ns = 0;
+    renderer->writer        = NULL;
+
+    renderer->stats.frames_presented = 0;
+    renderer->stats.frames_dropped   = 0;
+    renderer->stats.bytes_written    = 0;
+    renderer->stats.last_lag_ns      = 0;
+    renderer->stats.max_lag_ns       = 0;
+
+    return 1;
+}
+
+static void compose_frame(const Renderer *renderer, const Game *game, FrameBuffer *frame)
+{
+    frame_reset(frame);
+    game_render_frame(game, frame);
+    frame_printf(frame,
+                 "Frames: %llu shown, %llu dropped, lag %lld ms\033[K\n\033[J",
+                 renderer->stats.frames_presented, renderer->stats.frames_dropped,
+                 renderer->stats.last_lag_ns / 1000000LL);
+}
+
+/* The writer thread owns the counters in async mode; mirror them
+   so callers read RenderStats the same way in both modes. */
+static void sync_writer_stats(Renderer *renderer)
+{
+    AsyncWriter *writer = renderer->writer;
+
+    renderer->stats.frames_presented = atomic_load_explicit(&writer->frames_written,
+                                                            memory_order_relaxed);
+    renderer->stats.frames_dropped   = atomic_load_explicit(&writer->frames_replaced,
+                                                            memory_order_relaxed);
+    renderer->stats.bytes_written    = atomic_load_explicit(&writer->bytes_written,
+                                                            memory_order_relaxed);
+    renderer->stats.last_lag_ns      = atomic_load_explicit(&writer->last_lag_ns,
+                                                            memory_order_relaxed);
+    renderer->stats.max_lag_ns       = atomic_load_explicit(&writer->max_lag_ns,
+                                                            memory_order_relaxed);
+}
+
+int renderer_init(Renderer *renderer)
+{
+    if (!init_common(renderer)) {
+        return 0;
+    }
+
+    utils_stdout_set_nonblocking(1);
+    return 1;
+}
+
+int renderer_init_async(Renderer *renderer)
+{
+    if (!init_common(renderer)) {
+        return 0;
+    }
+
+    renderer->writer = (AsyncWriter *)malloc(sizeof(AsyncWriter));
+    if (!renderer->writer || !writer_start(renderer->writer)) {
+        free(renderer->writer);
+        frame_free(&renderer->frame);
+        renderer->writer = NULL;
+        return 0;
+    }
+
+    return 1;
+}
+
+void renderer_free(Renderer *renderer)
+{
+    if (!renderer) {
+        return;
+    }
+
+    if (renderer->writer) {
+        writer_stop(renderer->writer);
+        free(renderer->writer);
+        renderer->writer = NULL;
+    } else {
+        utils_stdout_set_nonblocking(0);
+    }
+    frame_free(&renderer->frame);
+}
+
+int renderer_flush(Renderer *renderer, long long now_ns)
+{
+    if (!renderer || !renderer->pending) {
+        return 1;
+    }
+
+    while (renderer->written < renderer->frame.length) {
+        long n = utils_write_stdout(renderer->frame.data + renderer->written,
+                                    renderer->frame.length - renderer->written);
+        if (n == 0) {
+            return 0;
+        }
+        if (n < 0) {
+            /* Output is gone (closed pipe, hung-up terminal); stop
+               trying rather than spinning on the same frame. */
+            renderer->pending = 0;
+            return 1;
+        }
+
+        renderer->written             += (size_t)n;
+        renderer->stats.bytes_written += (unsigned long long)n;
+    }
+
+    renderer->pending = 0;
+    renderer->stats.frames_presented++;
+    renderer->stats.last_lag_ns = now_ns - renderer->frame_time_ns;
+    if (renderer->stats.last_lag_ns > renderer->stats.max_lag_ns) {
+        renderer->stats.max_lag_ns = renderer->stats.last_lag_ns;
+    }
+
+    return 1;
+}
+
+void renderer_submit(Renderer *renderer, const Game *game, long long now_ns)
+{
+    if (!renderer || !game) {
+        return;
+    }
+
+    if (renderer->writer) {
+        compose_frame(renderer, game, writer_frame(renderer->writer));
+        writer_publish(renderer->writer, now_ns);
+        sync_writer_stats(renderer);
+        return;
+    }
+
+    if (renderer->pending) {
+        /* A frame that is partly on screen has to be completed, or the
+           terminal is left mid escape sequence. One that has not
+           started yet is simply replaced by the newer state. */
+        if (renderer->written > 0 && !renderer_flush(renderer, now_ns)) {
+            renderer->stats.frames_dropped++;
+            return;
+        }
+        if (renderer->pending) {
+            renderer->stats.frames_dropped++;
+        }
+    }
+
+    compose_frame(renderer, game, &renderer->frame);
+
+    renderer->written       = 0;
+    renderer->pending       = 1;
+    renderer->frame_time_ns = now_ns;
+
+    renderer_flush(renderer, now_ns);
+}
+
+void renderer_finish(Renderer *renderer, long long now_ns)
+{
+    if (!renderer) {
+        return;
+    }
+
+    if (renderer->writer) {
+        /* Stopping drains the last published frame. The writer is
+           released here, so renderer_free() has nothing left to stop. */
+        writer_stop(renderer->writer);
+        sync_writer_stats(renderer);
+        free(renderer->writer);
+        renderer->writer = NULL;
+        return;
+    }
+
+    if (renderer->pending && renderer->written > 0) {
+        utils_stdout_set_nonblocking(0);
+        renderer_flush(renderer, now_ns);
+    }
+    renderer->pending = 0;
+}
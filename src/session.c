@@ -0,0 +1,171 @@
+/*
+===========================================================
+ Project:    Snake Game in Console
+ File:       session.c
+ Author:     Mobin Yousefi (GitHub: github.com/mobinyousefi-cs)
+ Created:    2026-10-19
+ Updated:    2026-10-19
+ License:    MIT License (see LICENSE file for details)
+===========================================================
+
+ Description:
+    Implements the resumable game loop state machine and the
+    pump that drives it from a host event loop.
+===========================================================
+*/
+
+#include "session.h"
+
+#include "utils.h"
+
+static void apply_input(Game *game, InputAction action)
+{
+    switch (action) {
+    case INPUT_TURN_UP:
+        game_change_direction(game, DIR_UP);
+        break;
+    case INPUT_TURN_DOWN:
+        game_change_direction(game, DIR_DOWN);
+        break;
+    case INPUT_TURN_LEFT:
+        game_change_direction(game, DIR_LEFT);
+        break;
+    case INPUT_TURN_RIGHT:
+        game_change_direction(game, DIR_RIGHT);
+        break;
+    case INPUT_QUIT:
+        game->status = GAME_OVER_QUIT;
+        break;
+    case INPUT_NONE:
+    default:
+        break;
+    }
+}
+
+void session_init(GameSession *session, Game *game, Renderer *renderer,
+                  long long tick_ns, long long now_ns)
+{
+    if (!session) {
+        return;
+    }
+
+    session->game           = game;
+    session->renderer       = renderer;
+    session->phase          = game ? SESSION_INPUT : SESSION_FINISHED;
+    session->tick_ns        = tick_ns;
+    session->next_tick_ns   = now_ns;
+    session->tick_start_ns  = now_ns;
+    session->tick_jitter_ns = 0;
+    session->work_start_ns  = 0;
+    session->timing         = 0;
+    session->input_head     = 0;
+    session->input_tail     = 0;
+
+    metrics_report_reset(&session->report);
+}
+
+/* Turn action a bot's chosen direction maps to, for hosts that
+   feed policies through the input queue. */
+InputAction session_turn_input(Direction dir)
+{
+    static const InputAction actions[4] = {
+        INPUT_TURN_UP, INPUT_TURN_DOWN, INPUT_TURN_LEFT, INPUT_TURN_RIGHT
+    };
+    return ((unsigned)dir <= DIR_RIGHT) ? actions[dir] : INPUT_NONE;
+}
+
+int session_push_input(GameSession *session, InputAction action)
+{
+    if (!session || action == INPUT_NONE) {
+        return 0;
+    }
+
+    if (session->input_tail - session->input_head >= SESSION_INPUT_QUEUE) {
+        return 0;
+    }
+
+    session->inputs[session->input_tail++ % SESSION_INPUT_QUEUE] = action;
+    return 1;
+}
+
+long long session_pump(GameSession *session, long long now_ns)
+{
+    if (!session) {
+        return SESSION_DONE;
+    }
+
+    for (;;) {
+        switch (session->phase) {
+        case SESSION_WAIT:
+            if (session->renderer && session->renderer->pending) {
+                renderer_flush(session->renderer, now_ns);
+            }
+            if (now_ns < session->next_tick_ns) {
+                return session->next_tick_ns;
+            }
+            session->phase = SESSION_INPUT;
+            break;
+
+        case SESSION_INPUT:
+            session->tick_start_ns  = now_ns;
+            session->tick_jitter_ns = session->tick_start_ns - session->next_tick_ns;
+            if (session->tick_jitter_ns < 0) {
+                session->tick_jitter_ns = 0;
+            }
+            session->timing = metrics_count_tick(&session->report,
+                                                 (unsigned long long)session->tick_jitter_ns);
+            if (session->timing) {
+                session->work_start_ns = utils_now_ns();
+            }
+            if (session->input_head != session->input_tail) {
+                apply_input(session->game,
+                            session->inputs[session->input_head++ % SESSION_INPUT_QUEUE]);
+            }
+            session->phase = SESSION_UPDATE;
+            break;
+
+        case SESSION_UPDATE:
+            game_update(session->game);
+            session->phase = SESSION_RENDER;
+            break;
+
+        case SESSION_RENDER:
+            if (session->renderer) {
+                renderer_submit(session->renderer, session->game, now_ns);
+            }
+            if (session->timing) {
+                metrics_observe_tick(&session->report,
+                                     (unsigned long long)(utils_now_ns() - session->work_start_ns),
+                                     (unsigned long long)session->tick_jitter_ns);
+            }
+
+            if (session->game->status != GAME_RUNNING) {
+                session->phase = SESSION_FINISHED;
+                break;
+            }
+
+            /* Ticks missed while the host was busy are skipped
+               rather than replayed in a burst. */
+            session->next_tick_ns += session->tick_ns;
+            if (session->next_tick_ns < now_ns) {
+                session->next_tick_ns = now_ns;
+            }
+            session->phase = SESSION_WAIT;
+            return session->next_tick_ns;
+
+        case SESSION_FINISHED:
+        default:
+            return SESSION_DONE;
+        }
+    }
+}
+
+int session_is_done(const GameSession *session)
+{
+    return !session || session->phase == SESSION_FINISHED;
+}
+
+int session_wants_output(const GameSession *session)
+{
+    return session && session->renderer && session->renderer->pending;
+}
@@ -4,7 +4,7 @@
  File:       snake.c
  Author:     Mobin Yousefi (GitHub: github.com/mobinyousefi-cs)
  Created:    2025-11-26
- Updated:    2025-11-26
+ Updated:    2026-10-19
  License:    MIT License (see LICENSE file for details)
 ===========================================================
 
@@ -18,6 +18,10 @@
 
 #include <stdlib.h>
 
+const int       SNAKE_DIR_DX[4]       = { 0, 0, -1, 1 };
+const int       SNAKE_DIR_DY[4]       = { -1, 1, 0, 0 };
+const Direction SNAKE_DIR_OPPOSITE[4] = { DIR_DOWN, DIR_UP, DIR_RIGHT, DIR_LEFT };
+
 static SnakeNode *allocate_node(int x, int y)
 {
     SnakeNode *node = (SnakeNode *)malloc(sizeof(SnakeNode));
@@ -88,14 +92,7 @@ void snake_destroy(Snake *snake)
 
 void snake_set_direction(Snake *snake, Direction dir)
 {
-    if (!snake) {
-        return;
-    }
-
-    if ((snake->dir == DIR_UP && dir == DIR_DOWN) ||
-        (snake->dir == DIR_DOWN && dir == DIR_UP) ||
-        (snake->dir == DIR_LEFT && dir == DIR_RIGHT) ||
-        (snake->dir == DIR_RIGHT && dir == DIR_LEFT)) {
+    if (!snake || (unsigned)dir > DIR_RIGHT || dir == SNAKE_DIR_OPPOSITE[snake->dir]) {
         return;
     }
 
@@ -106,20 +103,8 @@ Position snake_next_head_position(const Snake *snake)
 {
     Position next = snake->head->pos;
 
-    switch (snake->dir) {
-    case DIR_UP:
-        next.y -= 1;
-        break;
-    case DIR_DOWN:
-        next.y += 1;
-        break;
-    case DIR_LEFT:
-        next.x -= 1;
-        break;
-    case DIR_RIGHT:
-        next.x += 1;
-        break;
-    }
+    next.x += SNAKE_DIR_DX[snake->dir];
+    next.y += SNAKE_DIR_DY[snake->dir];
 
     return next;
 }
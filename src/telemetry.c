@@ -0,0 +1,310 @@
+/*
+===========================================================
+ Project:    Snake Game in Console
+ File:       telemetry.c
+ Author:     Mobin Yousefi (GitHub: github.com/mobinyousefi-cs)
+ Created:    2026-10-19
+ Updated:    2026-10-19
+ License:    MIT License (see LICENSE file for details)
+===========================================================
+
+ Description:
+    Implements the lock-free metric registry and its
+    Prometheus text and JSONL exporters.
+===========================================================
+*/
+
+#include "telemetry.h"
+
+#include <string.h>
+#include <time.h>
+
+#define TEMP_SUFFIX  ".tmp"
+
+static size_t bucket_for(unsigned long long value)
+{
+    unsigned long long bound = 1ULL << TELEMETRY_BUCKET_MIN_LOG2;
+    size_t             index = 0;
+
+    while (index < TELEMETRY_BUCKET_COUNT - 1 && value > bound) {
+        bound <<= 1;
+        index++;
+    }
+
+    return index;
+}
+
+static double bucket_bound_seconds(size_t index)
+{
+    return (double)(1ULL << (TELEMETRY_BUCKET_MIN_LOG2 + index)) / 1e9;
+}
+
+/* Length of the metric name without any {label="..."} suffix. */
+static size_t base_name_length(const char *name)
+{
+    const char *brace = strchr(name, '{');
+    return brace ? (size_t)(brace - name) : strlen(name);
+}
+
+static void write_json_string(FILE *out, const char *text)
+{
+    fputc('"', out);
+    for (; *text; ++text) {
+        if (*text == '"' || *text == '\\') {
+            fputc('\\', out);
+        }
+        fputc(*text, out);
+    }
+    fputc('"', out);
+}
+
+void telemetry_init(TelemetryRegistry *registry)
+{
+    if (!registry) {
+        return;
+    }
+
+    memset(registry, 0, sizeof(*registry));
+    atomic_init(&registry->count, 0);
+
+    for (size_t i = 0; i < TELEMETRY_MAX_METRICS; ++i) {
+        atomic_init(&registry->metrics[i].ready, 0);
+    }
+}
+
+TelemetryMetric *telemetry_register(TelemetryRegistry *registry, const char *name,
+                                    const char *help, MetricKind kind)
+{
+    if (!registry || !name) {
+        return NULL;
+    }
+
+    size_t slot = atomic_fetch_add(&registry->count, 1);
+    if (slot >= TELEMETRY_MAX_METRICS) {
+        atomic_fetch_sub(&registry->count, 1);
+        return NULL;
+    }
+
+    TelemetryMetric *metric = &registry->metrics[slot];
+    metric->name = name;
+    metric->help = help ? help : "";
+    metric->kind = kind;
+    atomic_init(&metric->value, 0);
+    atomic_init(&metric->sum, 0);
+    for (size_t i = 0; i < TELEMETRY_BUCKET_COUNT; ++i) {
+        atomic_init(&metric->buckets[i], 0);
+    }
+
+    atomic_store_explicit(&metric->ready, 1, memory_order_release);
+    return metric;
+}
+
+void telemetry_add(TelemetryMetric *metric, unsigned long long amount)
+{
+    if (metric) {
+        atomic_fetch_add_explicit(&metric->value, amount, memory_order_relaxed);
+    }
+}
+
+void telemetry_set(TelemetryMetric *metric, unsigned long long value)
+{
+    if (metric) {
+        atomic_store_explicit(&metric->value, value, memory_order_relaxed);
+    }
+}
+
+void telemetry_max(TelemetryMetric *metric, unsigned long long value)
+{
+    if (!metric) {
+        return;
+    }
+
+    unsigned long long current = atomic_load_explicit(&metric->value, memory_order_relaxed);
+    while (value > current &&
+           !atomic_compare_exchange_weak_explicit(&metric->value, &current, value,
+                                                  memory_order_relaxed,
+                                                  memory_order_relaxed)) {
+    }
+}
+
+void telemetry_merge(TelemetryMetric *metric, const TelemetryHistogram *local)
+{
+    if (!metric || !local || local->count == 0) {
+        return;
+    }
+
+    for (size_t i = 0; i < TELEMETRY_BUCKET_COUNT; ++i) {
+        if (local->buckets[i]) {
+            atomic_fetch_add_explicit(&metric->buckets[i], local->buckets[i],
+                                      memory_order_relaxed);
+        }
+    }
+    atomic_fetch_add_explicit(&metric->sum, local->sum, memory_order_relaxed);
+    atomic_fetch_add_explicit(&metric->value, local->count, memory_order_relaxed);
+}
+
+void telemetry_histogram_reset(TelemetryHistogram *histogram)
+{
+    if (histogram) {
+        memset(histogram, 0, sizeof(*histogram));
+    }
+}
+
+void telemetry_histogram_observe(TelemetryHistogram *histogram, unsigned long long value)
+{
+    histogram->buckets[bucket_for(value)]++;
+    histogram->count++;
+    histogram->sum += value;
+}
+
+int telemetry_write_prometheus(TelemetryRegistry *registry, FILE *out)
+{
+    if (!registry || !out) {
+        return 0;
+    }
+
+    size_t      count    = atomic_load(&registry->count);
+    const char *previous = NULL;
+
+    for (size_t i = 0; i < count && i < TELEMETRY_MAX_METRICS; ++i) {
+        TelemetryMetric *metric = &registry->metrics[i];
+        if (!atomic_load_explicit(&metric->ready, memory_order_acquire)) {
+            continue;
+        }
+
+        size_t base = base_name_length(metric->name);
+
+        /* Labelled series of one family share a single HELP/TYPE block. */
+        if (!previous || base_name_length(previous) != base ||
+            strncmp(previous, metric->name, base) != 0) {
+            static const char *type_names[] = { "counter", "gauge", "histogram" };
+            fprintf(out, "# HELP %.*s %s\n", (int)base, metric->name, metric->help);
+            fprintf(out, "# TYPE %.*s %s\n", (int)base, metric->name, type_names[metric->kind]);
+        }
+        previous = metric->name;
+
+        if (metric->kind != METRIC_HISTOGRAM) {
+            fprintf(out, "%s %llu\n", metric->name,
+                    atomic_load_explicit(&metric->value, memory_order_relaxed));
+            continue;
+        }
+
+        unsigned long long cumulative = 0;
+        for (size_t b = 0; b < TELEMETRY_BUCKET_COUNT; ++b) {
+            cumulative += atomic_load_explicit(&metric->buckets[b], memory_order_relaxed);
+            if (b + 1 < TELEMETRY_BUCKET_COUNT) {
+                fprintf(out, "%s_bucket{le=\"%g\"} %llu\n", metric->name,
+                        bucket_bound_seconds(b), cumulative);
+            } else {
+                fprintf(out, "%s_bucket{le=\"+Inf\"} %llu\n", metric->name, cumulative);
+            }
+        }
+        fprintf(out, "%s_sum %.9f\n", metric->name,
+                (double)atomic_load_explicit(&metric->sum, memory_order_relaxed) / 1e9);
+        fprintf(out, "%s_count %llu\n", metric->name,
+                atomic_load_explicit(&metric->value, memory_order_relaxed));
+    }
+
+    return !ferror(out);
+}
+
+int telemetry_write_jsonl(TelemetryRegistry *registry, FILE *out, long long timestamp_ms)
+{
+    if (!registry || !out) {
+        return 0;
+    }
+
+    size_t count = atomic_load(&registry->count);
+    int    first = 1;
+
+    fprintf(out, "{\"type\":\"aggregate\",\"time_ms\":%lld,\"metrics\":{", timestamp_ms);
+
+    for (size_t i = 0; i < count && i < TELEMETRY_MAX_METRICS; ++i) {
+        TelemetryMetric *metric = &registry->metrics[i];
+        if (!atomic_load_explicit(&metric->ready, memory_order_acquire)) {
+            continue;
+        }
+
+        if (!first) {
+            fputc(',', out);
+        }
+        first = 0;
+
+        write_json_string(out, metric->name);
+        fputc(':', out);
+
+        if (metric->kind != METRIC_HISTOGRAM) {
+            fprintf(out, "%llu", atomic_load_explicit(&metric->value, memory_order_relaxed));
+            continue;
+        }
+
+        fprintf(out, "{\"count\":%llu,\"sum_ns\":%llu,\"buckets_le_ns\":{",
+                atomic_load_explicit(&metric->value, memory_order_relaxed),
+                atomic_load_explicit(&metric->sum, memory_order_relaxed));
+        for (size_t b = 0; b < TELEMETRY_BUCKET_COUNT; ++b) {
+            unsigned long long n = atomic_load_explicit(&metric->buckets[b], memory_order_relaxed);
+            if (b + 1 < TELEMETRY_BUCKET_COUNT) {
+                fprintf(out, "%s\"%llu\":%llu", b ? "," : "",
+                        1ULL << (TELEMETRY_BUCKET_MIN_LOG2 + b), n);
+            } else {
+                fprintf(out, ",\"+Inf\":%llu", n);
+            }
+        }
+        fputs("}}", out);
+    }
+
+    fputs("}}\n", out);
+    return !ferror(out);
+}
+
+long long telemetry_wall_clock_ms(void)
+{
+    struct timespec ts;
+    if (timespec_get(&ts, TIME_UTC) != TIME_UTC) {
+        return (long long)time(NULL) * 1000LL;
+    }
+    return (long long)ts.tv_sec * 1000LL + ts.tv_nsec / 1000000L;
+}
+
+int telemetry_export_file(TelemetryRegistry *registry, const char *path,
+                          TelemetryFormat format)
+{
+    if (!registry || !path) {
+        return 0;
+    }
+
+    if (format == TELEMETRY_JSONL) {
+        FILE *out = fopen(path, "a");
+        if (!out) {
+            return 0;
+        }
+        int ok = telemetry_write_jsonl(registry, out, telemetry_wall_clock_ms());
+        return (fclose(out) == 0) && ok;
+    }
+
+    /* Prometheus textfile collectors may read at any moment, so the
+       snapshot is written aside and renamed over the old one. */
+    size_t length = strlen(path);
+    char   temp[4096];
+    if (length + sizeof(TEMP_SUFFIX) > sizeof(temp)) {
+        return 0;
+    }
+    memcpy(temp, path, length);
+    memcpy(temp + length, TEMP_SUFFIX, sizeof(TEMP_SUFFIX));
+
+    FILE *out = fopen(temp, "w");
+    if (!out) {
+        return 0;
+    }
+
+    int ok = telemetry_write_prometheus(registry, out);
+    if (fclose(out) != 0 || !ok) {
+        remove(temp);
+        return 0;
+    }
+
+#ifdef _WIN32
+    remove(path);
+#endif
+    return rename(temp, path) == 0;
+}
@@ -0,0 +1,273 @@
+/*
+===========================================================
+ Project:    Snake Game in Console
+ File:       tensor.c
+ Author:     Mobin Yousefi (GitHub: github.com/mobinyousefi-cs)
+ Created:    2026-10-19
+ Updated:    2026-10-19
+ License:    MIT License (see LICENSE file for details)
+===========================================================
+
+ Description:
+    Converts game states into float32 feature planes: a
+    vectorized byte-to-float pass over the dense grid for
+    the body plane, point writes for head and food, constant
+    fills for the direction one-hot, and a ring of recorded
+    frames for history stacking.
+===========================================================
+*/
+
+#include "tensor.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __SSE2__
+#  include <emmintrin.h>
+#endif
+
+/* dst[i] = (src[i] == match) ? 1.0f : 0.0f for i in [0, n). */
+static void convert_row(const unsigned char *src, int n, unsigned char match, float *dst)
+{
+    int i = 0;
+
+#ifdef __SSE2__
+    /* Widen the 0x00/0xFF compare mask to 32 bits and keep the bits
+       of 1.0f where it is set. */
+    const __m128i want = _mm_set1_epi8((char)match);
+    const __m128i one  = _mm_castps_si128(_mm_set1_ps(1.0f));
+
+    for (; i + 16 <= n; i += 16) {
+        __m128i mask = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(src + i)), want);
+        __m128i lo   = _mm_unpacklo_epi8(mask, mask);
+        __m128i hi   = _mm_unpackhi_epi8(mask, mask);
+
+        _mm_storeu_si128((__m128i *)(dst + i),      _mm_and_si128(_mm_unpacklo_epi16(lo, lo), one));
+        _mm_storeu_si128((__m128i *)(dst + i + 4),  _mm_and_si128(_mm_unpackhi_epi16(lo, lo), one));
+        _mm_storeu_si128((__m128i *)(dst + i + 8),  _mm_and_si128(_mm_unpacklo_epi16(hi, hi), one));
+        _mm_storeu_si128((__m128i *)(dst + i + 12), _mm_and_si128(_mm_unpackhi_epi16(hi, hi), one));
+    }
+#endif
+
+    for (; i < n; ++i) {
+        dst[i] = (src[i] == match) ? 1.0f : 0.0f;
+    }
+}
+
+static void fill_plane(float *dst, size_t n, float value)
+{
+    if (value == 0.0f) {
+        memset(dst, 0, n * sizeof(float));
+        return;
+    }
+    for (size_t i = 0; i < n; ++i) {
+        dst[i] = value;
+    }
+}
+
+static void mark_point(float *plane, int width, int height, Position pos)
+{
+    if (pos.x >= 0 && pos.x < width && pos.y >= 0 && pos.y < height) {
+        plane[(size_t)pos.y * (size_t)width + (size_t)pos.x] = 1.0f;
+    }
+}
+
+/* Writes one frame of TENSOR_PLANES planes. The body comes from
+   `rows` (row_stride bytes apart) when given, otherwise from
+   per-cell lookups on `board`. */
+static void write_frame(float *dst, int width, int height,
+                        const unsigned char *rows, size_t row_stride, const Board *board,
+                        Position head, Position food, Direction dir)
+{
+    const size_t plane = (size_t)width * (size_t)height;
+    float       *body  = dst + (size_t)TENSOR_BODY * plane;
+
+    if (rows) {
+        for (int y = 0; y < height; ++y) {
+            convert_row(rows + (size_t)y * row_stride, width, (unsigned char)CELL_BODY,
+                        body + (size_t)y * (size_t)width);
+        }
+    } else {
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                body[(size_t)y * (size_t)width + (size_t)x] =
+                    (board_cell_at(board, x, y) == CELL_BODY) ? 1.0f : 0.0f;
+            }
+        }
+    }
+
+    float *head_plane = dst + (size_t)TENSOR_HEAD * plane;
+    float *food_plane = dst + (size_t)TENSOR_FOOD * plane;
+    memset(head_plane, 0, 2 * plane * sizeof(float));
+    mark_point(head_plane, width, height, head);
+    mark_point(food_plane, width, height, food);
+
+    for (int d = 0; d < 4; ++d) {
+        fill_plane(dst + (size_t)(TENSOR_DIR_UP + d) * plane, plane,
+                   (d == (int)dir) ? 1.0f : 0.0f);
+    }
+}
+
+static void write_game(float *dst, const Game *game)
+{
+    const Board *board = game->board;
+
+    if (board->cells) {
+        write_frame(dst, board->width, board->height,
+                    board->cells + board_cell_index(board, 0, 0), (size_t)board->stride, NULL,
+                    game->snake->head->pos, board->food, game->snake->dir);
+    } else {
+        write_frame(dst, board->width, board->height, NULL, 0, board,
+                    game->snake->head->pos, board->food, game->snake->dir);
+    }
+}
+
+size_t tensor_sample_floats(int width, int height, int depth)
+{
+    return (size_t)depth * TENSOR_PLANES * (size_t)width * (size_t)height;
+}
+
+int tensor_export(const Game *const *games, size_t count, float *out)
+{
+    if (!games || count == 0 || !out || !games[0]) {
+        return 0;
+    }
+
+    const int width  = games[0]->board->width;
+    const int height = games[0]->board->height;
+
+    for (size_t i = 1; i < count; ++i) {
+        if (!games[i] || games[i]->board->width != width || games[i]->board->height != height) {
+            return 0;
+        }
+    }
+
+    const size_t sample = tensor_sample_floats(width, height, 1);
+    for (size_t i = 0; i < count; ++i) {
+        write_game(out + i * sample, games[i]);
+    }
+    return 1;
+}
+
+TensorHistory *tensor_history_create(int width, int height, int depth)
+{
+    if (width <= 0 || height <= 0 || depth <= 0) {
+        return NULL;
+    }
+
+    TensorHistory *history = (TensorHistory *)calloc(1, sizeof(TensorHistory));
+    if (!history) {
+        return NULL;
+    }
+
+    const size_t plane = (size_t)width * (size_t)height;
+    history->width   = width;
+    history->height  = height;
+    history->depth   = depth;
+    history->frames  = (TensorFrame *)calloc((size_t)depth, sizeof(TensorFrame));
+    history->storage = (unsigned char *)malloc((size_t)depth * plane);
+
+    if (!history->frames || !history->storage) {
+        tensor_history_destroy(history);
+        return NULL;
+    }
+
+    for (int k = 0; k < depth; ++k) {
+        history->frames[k].body = history->storage + (size_t)k * plane;
+    }
+    tensor_history_reset(history);
+    return history;
+}
+
+void tensor_history_destroy(TensorHistory *history)
+{
+    if (!history) {
+        return;
+    }
+    free(history->frames);
+    free(history->storage);
+    free(history);
+}
+
+void tensor_history_reset(TensorHistory *history)
+{
+    history->count  = 0;
+    history->newest = history->depth - 1;
+}
+
+int tensor_history_push(TensorHistory *history, const Game *game)
+{
+    const Board *board  = game->board;
+    const int    width  = history->width;
+    const int    height = history->height;
+
+    if (board->width != width || board->height != height) {
+        return 0;
+    }
+
+    history->newest = (history->newest + 1) % history->depth;
+    if (history->count < history->depth) {
+        history->count++;
+    }
+
+    TensorFrame   *frame = &history->frames[history->newest];
+    unsigned char *body  = frame->body;
+
+    if (board->cells) {
+        for (int y = 0; y < height; ++y) {
+            memcpy(body + (size_t)y * (size_t)width,
+                   board->cells + board_cell_index(board, 0, y), (size_t)width);
+        }
+    } else {
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                body[(size_t)y * (size_t)width + (size_t)x] =
+                    (unsigned char)board_cell_at(board, x, y);
+            }
+        }
+    }
+
+    frame->head = game->snake->head->pos;
+    frame->food = board->food;
+    frame->dir  = game->snake->dir;
+    return 1;
+}
+
+int tensor_export_history(const TensorHistory *const *histories, size_t count, float *out)
+{
+    if (!histories || count == 0 || !out || !histories[0]) {
+        return 0;
+    }
+
+    const int width  = histories[0]->width;
+    const int height = histories[0]->height;
+    const int depth  = histories[0]->depth;
+
+    for (size_t i = 1; i < count; ++i) {
+        const TensorHistory *history = histories[i];
+        if (!history || history->width != width || history->height != height ||
+            history->depth != depth) {
+            return 0;
+        }
+    }
+
+    const size_t frame_floats = tensor_sample_floats(width, height, 1);
+    const size_t sample       = tensor_sample_floats(width, height, depth);
+
+    for (size_t i = 0; i < count; ++i) {
+        const TensorHistory *history = histories[i];
+        float                *dst     = out + i * sample;
+
+        for (int k = 0; k < depth; ++k, dst += frame_floats) {
+            if (k >= history->count) {
+                memset(dst, 0, frame_floats * sizeof(float));
+                continue;
+            }
+
+            const TensorFrame *frame = &history->frames[(history->newest - k + depth) % depth];
+            write_frame(dst, width, height, frame->body, (size_t)width, NULL,
+                        frame->head, frame->food, frame->dir);
+        }
+    }
+    return 1;
+}
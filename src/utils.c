@@ -4,7 +4,7 @@
  File:       utils.c
  Author:     Mobin Yousefi (GitHub: github.com/mobinyousefi-cs)
  Created:    2025-11-26
- Updated:    2025-11-26
+ Updated:    2026-10-19
  License:    MIT License (see LICENSE file for details)
 ===========================================================
 
@@ -13,13 +13,105 @@
       - raw terminal configuration (POSIX)
       - non-blocking input
       - clear screen
-      - millisecond sleep
+      - millisecond sleep and monotonic clock
+      - non-blocking frame output
+      - shared random, parsing and clamping helpers
 ===========================================================
 */
 
+#ifndef _WIN32
+#  define _POSIX_C_SOURCE 200809L
+#endif
+
 #include "utils.h"
 
+#include <errno.h>
+#include <limits.h>
 #include <stdio.h>
+#include <stdlib.h>
+
+/* SplitMix64 scramble so that small or zero seeds still give a
+   non-zero, well-mixed xorshift state. */
+uint64_t utils_splitmix64(uint64_t seed)
+{
+    uint64_t z = seed + 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z = z ^ (z >> 31);
+
+    return z ? z : 0x2545F4914F6CDD1DULL;
+}
+
+/* xorshift64*: one step of the stream in *state, which must be
+   non-zero. */
+uint64_t utils_xorshift(uint64_t *state)
+{
+    uint64_t x = *state;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *state = x;
+    return x * 0x2545F4914F6CDD1DULL;
+}
+
+/* Whole-string base-10 parse; trailing garbage, overflow and values
+   below min are all rejected. */
+int utils_parse_long(const char *text, long min, long *out)
+{
+    char *end   = NULL;
+    long  value = 0;
+
+    if (!text || !out) {
+        return 0;
+    }
+
+    errno = 0;
+    value = strtol(text, &end, 10);
+    if (end == text || *end != '\0' || errno == ERANGE || value < min) {
+        return 0;
+    }
+    *out = value;
+    return 1;
+}
+
+/* Strict "WxH" parse with both sides positive and within int. */
+int utils_parse_size(const char *text, int *width, int *height)
+{
+    char *end = NULL;
+    long  w   = 0;
+    long  h   = 0;
+
+    if (!text || !width || !height) {
+        return 0;
+    }
+
+    errno = 0;
+    w     = strtol(text, &end, 10);
+    if (end == text || *end != 'x' || errno == ERANGE || w <= 0 || w > INT_MAX) {
+        return 0;
+    }
+
+    text = end + 1;
+    h    = strtol(text, &end, 10);
+    if (end == text || *end != '\0' || errno == ERANGE || h <= 0 || h > INT_MAX) {
+        return 0;
+    }
+
+    *width  = (int)w;
+    *height = (int)h;
+    return 1;
+}
+
+/* Origin of an extent-wide window centred on center, kept inside
+   [0, size). */
+int utils_clamp_origin(int center, int extent, int size)
+{
+    int origin = center - extent / 2;
+    if (origin > size - extent) {
+        origin = size - extent;
+    }
+    return (origin < 0) ? 0 : origin;
+}
 
 #ifdef _WIN32
 
@@ -28,6 +120,13 @@
 
 int utils_terminal_init(void)
 {
+    /* Frames are drawn with ANSI cursor sequences, which the Windows
+       console only interprets once VT processing is switched on. */
+    HANDLE out  = GetStdHandle(STD_OUTPUT_HANDLE);
+    DWORD  mode = 0;
+    if (out != INVALID_HANDLE_VALUE && GetConsoleMode(out, &mode)) {
+        SetConsoleMode(out, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+    }
     return 1;
 }
 
@@ -45,6 +144,19 @@ void utils_sleep_ms(int ms)
     Sleep((DWORD)ms);
 }
 
+long long utils_now_ns(void)
+{
+    static LARGE_INTEGER frequency;
+    LARGE_INTEGER        counter;
+
+    if (frequency.QuadPart == 0) {
+        QueryPerformanceFrequency(&frequency);
+    }
+    QueryPerformanceCounter(&counter);
+
+    return (long long)((double)counter.QuadPart * 1e9 / (double)frequency.QuadPart);
+}
+
 int utils_kbhit(void)
 {
     return _kbhit();
@@ -55,15 +167,42 @@ int utils_getch(void)
     return _getch();
 }
 
+int utils_stdout_set_nonblocking(int enable)
+{
+    (void)enable;
+    return 0;
+}
+
+long utils_write_stdout(const char *data, size_t length)
+{
+    size_t n = fwrite(data, 1, length, stdout);
+    fflush(stdout);
+    return (n == 0 && length > 0) ? -1 : (long)n;
+}
+
+int utils_wait_stdout_writable(int timeout_ms)
+{
+    (void)timeout_ms;
+    return 1;
+}
+
 #else /* POSIX */
 
+#  include <fcntl.h>
+#  include <poll.h>
 #  include <termios.h>
 #  include <unistd.h>
 #  include <sys/select.h>
 #  include <time.h>
 
+#  ifndef PIPE_BUF
+#    define PIPE_BUF 512
+#  endif
+
 static struct termios g_orig_termios;
 static int            g_terminal_configured = 0;
+static int            g_stdout_nonblocking  = 0;
+static int            g_private_out_fd      = -1;
 
 int utils_terminal_init(void)
 {
@@ -92,6 +231,8 @@ int utils_terminal_init(void)
 
 void utils_terminal_restore(void)
 {
+    utils_stdout_set_nonblocking(0);
+
     if (!g_terminal_configured) {
         return;
     }
@@ -114,6 +255,13 @@ void utils_sleep_ms(int ms)
     nanosleep(&ts, NULL);
 }
 
+long long utils_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
 int utils_kbhit(void)
 {
     struct timeval tv;
@@ -139,4 +287,73 @@ int utils_getch(void)
     return (int)ch;
 }
 
+static int output_fd(void)
+{
+    return (g_private_out_fd >= 0) ? g_private_out_fd : STDOUT_FILENO;
+}
+
+/* O_NONBLOCK belongs to the open file description, which a terminal
+   shares with stdin, stderr and the shell, so stdout itself is never
+   switched: a killed game would leave the shell's tty non-blocking.
+   A terminal is reopened to get a description of our own instead;
+   anything else is written at most PIPE_BUF bytes at a time once
+   poll() reports room, which a pipe accepts without blocking. */
+int utils_stdout_set_nonblocking(int enable)
+{
+    if (!enable) {
+        if (g_private_out_fd >= 0) {
+            close(g_private_out_fd);
+            g_private_out_fd = -1;
+        }
+        g_stdout_nonblocking = 0;
+        return 1;
+    }
+
+    if (!g_stdout_nonblocking && isatty(STDOUT_FILENO)) {
+        const char *name = ttyname(STDOUT_FILENO);
+        if (name) {
+            g_private_out_fd = open(name, O_WRONLY | O_NONBLOCK | O_NOCTTY);
+        }
+    }
+    g_stdout_nonblocking = 1;
+    return 1;
+}
+
+long utils_write_stdout(const char *data, size_t length)
+{
+    if (g_stdout_nonblocking && g_private_out_fd < 0) {
+        if (!utils_wait_stdout_writable(0)) {
+            return 0;
+        }
+        if (length > PIPE_BUF) {
+            length = PIPE_BUF;
+        }
+    }
+
+    for (;;) {
+        ssize_t n = write(output_fd(), data, length);
+        if (n >= 0) {
+            return (long)n;
+        }
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            return 0;
+        }
+        if (errno != EINTR) {
+            return -1;
+        }
+    }
+}
+
+int utils_wait_stdout_writable(int timeout_ms)
+{
+    struct pollfd pfd;
+
+    pfd.fd      = output_fd();
+    pfd.events  = POLLOUT;
+    pfd.revents = 0;
+
+    int ret = poll(&pfd, 1, timeout_ms);
+    return (ret > 0) && (pfd.revents & (POLLOUT | POLLERR | POLLHUP));
+}
+
 #endif /* _WIN32 */
@@ -0,0 +1,183 @@
+/*
+===========================================================
+ Project:    Snake Game in Console
+ File:       writer.c
+ Author:     Mobin Yousefi (GitHub: github.com/mobinyousefi-cs)
+ Created:    2026-10-19
+ Updated:    2026-10-19
+ License:    MIT License (see LICENSE file for details)
+===========================================================
+
+ Description:
+    Implements the writer thread and the lock-free buffer
+    rotation used to hand finished frames to it.
+===========================================================
+*/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "writer.h"
+
+#include "utils.h"
+
+#define SLOT_INDEX  0x3
+#define SLOT_FRESH  0x4
+
+#define FRAME_INITIAL_CAPACITY  4096
+
+static void write_frame(AsyncWriter *writer, int index)
+{
+    const FrameBuffer *frame   = &writer->buffers[index];
+    size_t             written = 0;
+
+    while (written < frame->length) {
+        long n = utils_write_stdout(frame->data + written, frame->length - written);
+        if (n < 0) {
+            return;
+        }
+        if (n == 0) {
+            utils_wait_stdout_writable(100);
+            continue;
+        }
+        written += (size_t)n;
+    }
+
+    long long lag = utils_now_ns() - writer->publish_ns[index];
+
+    atomic_fetch_add_explicit(&writer->frames_written, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&writer->bytes_written, written, memory_order_relaxed);
+    atomic_store_explicit(&writer->last_lag_ns, lag, memory_order_relaxed);
+    if (lag > atomic_load_explicit(&writer->max_lag_ns, memory_order_relaxed)) {
+        atomic_store_explicit(&writer->max_lag_ns, lag, memory_order_relaxed);
+    }
+}
+
+/* Swaps the writer's spent buffer for the freshest published one. */
+static int take_fresh(AsyncWriter *writer)
+{
+    if (!(atomic_load_explicit(&writer->mailbox, memory_order_acquire) & SLOT_FRESH)) {
+        return 0;
+    }
+
+    int slot = atomic_exchange_explicit(&writer->mailbox, writer->consumer,
+                                        memory_order_acq_rel);
+    writer->consumer = slot & SLOT_INDEX;
+    return 1;
+}
+
+static void *writer_main(void *arg)
+{
+    AsyncWriter *writer = (AsyncWriter *)arg;
+
+    for (;;) {
+        if (take_fresh(writer)) {
+            write_frame(writer, writer->consumer);
+            continue;
+        }
+
+        if (atomic_load_explicit(&writer->stop, memory_order_acquire)) {
+            /* The last frame may have been published just before stop. */
+            if (take_fresh(writer)) {
+                write_frame(writer, writer->consumer);
+            }
+            return NULL;
+        }
+
+        pthread_mutex_lock(&writer->lock);
+        while (!(atomic_load(&writer->mailbox) & SLOT_FRESH) && !atomic_load(&writer->stop)) {
+            pthread_cond_wait(&writer->wake, &writer->lock);
+        }
+        pthread_mutex_unlock(&writer->lock);
+    }
+}
+
+int writer_start(AsyncWriter *writer)
+{
+    if (!writer) {
+        return 0;
+    }
+
+    for (int i = 0; i < WRITER_BUFFERS; ++i) {
+        writer->publish_ns[i] = 0;
+        if (!frame_init(&writer->buffers[i], FRAME_INITIAL_CAPACITY)) {
+            while (i-- > 0) {
+                frame_free(&writer->buffers[i]);
+            }
+            return 0;
+        }
+    }
+
+    writer->producer = 0;
+    writer->consumer = 2;
+    writer->running  = 0;
+    atomic_init(&writer->mailbox, 1);
+    atomic_init(&writer->stop, 0);
+    atomic_init(&writer->frames_written, 0);
+    atomic_init(&writer->frames_replaced, 0);
+    atomic_init(&writer->bytes_written, 0);
+    atomic_init(&writer->last_lag_ns, 0);
+    atomic_init(&writer->max_lag_ns, 0);
+
+    pthread_mutex_init(&writer->lock, NULL);
+    pthread_cond_init(&writer->wake, NULL);
+
+    if (pthread_create(&writer->thread, NULL, writer_main, writer) != 0) {
+        pthread_cond_destroy(&writer->wake);
+        pthread_mutex_destroy(&writer->lock);
+        for (int i = 0; i < WRITER_BUFFERS; ++i) {
+            frame_free(&writer->buffers[i]);
+        }
+        return 0;
+    }
+
+    writer->running = 1;
+    return 1;
+}
+
+void writer_stop(AsyncWriter *writer)
+{
+    if (!writer || !writer->running) {
+        return;
+    }
+
+    pthread_mutex_lock(&writer->lock);
+    atomic_store(&writer->stop, 1);
+    pthread_cond_signal(&writer->wake);
+    pthread_mutex_unlock(&writer->lock);
+
+    pthread_join(writer->thread, NULL);
+    writer->running = 0;
+
+    pthread_cond_destroy(&writer->wake);
+    pthread_mutex_destroy(&writer->lock);
+    for (int i = 0; i < WRITER_BUFFERS; ++i) {
+        frame_free(&writer->buffers[i]);
+    }
+}
+
+FrameBuffer *writer_frame(AsyncWriter *writer)
+{
+    FrameBuffer *frame = &writer->buffers[writer->producer];
+    frame_reset(frame);
+    return frame;
+}
+
+void writer_publish(AsyncWriter *writer, long long now_ns)
+{
+    writer->publish_ns[writer->producer] = now_ns;
+
+    int slot = atomic_exchange_explicit(&writer->mailbox, writer->producer | SLOT_FRESH,
+                                        memory_order_acq_rel);
+    writer->producer = slot & SLOT_INDEX;
+
+    if (slot & SLOT_FRESH) {
+        /* The writer never got to the previous frame; it is dropped
+           and the writer is already due to wake. */
+        atomic_fetch_add_explicit(&writer->frames_replaced, 1, memory_order_relaxed);
+        return;
+    }
+
+    pthread_mutex_lock(&writer->lock);
+    pthread_cond_signal(&writer->wake);
+    pthread_mutex_unlock(&writer->lock);
+}
@@ -0,0 +1,91 @@
+/*
+===========================================================
+ Project:    Snake Game in Console
+ File:       telemetry.h
+ Author:     Mobin Yousefi (GitHub: github.com/mobinyousefi-cs)
+ Created:    2026-10-19
+ Updated:    2026-10-19
+ License:    MIT License (see LICENSE file for details)
+===========================================================
+
+ Description:
+    Lock-free metric registry with counters, gauges, and
+    log2 histograms, exported as Prometheus text or JSONL.
+
+ Notes:
+    - Registration claims a slot with an atomic increment and
+      publishes it with a release store, so registering and
+      updating never take a lock.
+    - Histograms observe nanoseconds and are exported in
+      seconds, following Prometheus naming conventions.
+    - Updates are relaxed atomics. Hot loops should keep a
+      plain TelemetryHistogram or local counters and merge
+      them in batches, leaving the per-tick cost at a few
+      ordinary increments.
+===========================================================
+*/
+
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <stdatomic.h>
+#include <stdio.h>
+
+#define TELEMETRY_MAX_METRICS     32
+#define TELEMETRY_BUCKET_COUNT    24
+#define TELEMETRY_BUCKET_MIN_LOG2 10   /* first bucket: <= 1024 ns */
+
+typedef enum MetricKind {
+    METRIC_COUNTER = 0,
+    METRIC_GAUGE,
+    METRIC_HISTOGRAM
+} MetricKind;
+
+typedef enum TelemetryFormat {
+    TELEMETRY_PROMETHEUS = 0,
+    TELEMETRY_JSONL
+} TelemetryFormat;
+
+typedef struct TelemetryHistogram {
+    unsigned long long buckets[TELEMETRY_BUCKET_COUNT];
+    unsigned long long count;
+    unsigned long long sum;
+} TelemetryHistogram;
+
+typedef struct TelemetryMetric {
+    const char    *name;
+    const char    *help;
+    MetricKind     kind;
+    atomic_int     ready;
+    atomic_ullong  value;
+    atomic_ullong  buckets[TELEMETRY_BUCKET_COUNT];
+    atomic_ullong  sum;
+} TelemetryMetric;
+
+typedef struct TelemetryRegistry {
+    TelemetryMetric metrics[TELEMETRY_MAX_METRICS];
+    atomic_size_t   count;
+} TelemetryRegistry;
+
+void             telemetry_init(TelemetryRegistry *registry);
+
+TelemetryMetric *telemetry_register(TelemetryRegistry *registry, const char *name,
+                                    const char *help, MetricKind kind);
+
+void             telemetry_add(TelemetryMetric *metric, unsigned long long amount);
+void             telemetry_set(TelemetryMetric *metric, unsigned long long value);
+void             telemetry_max(TelemetryMetric *metric, unsigned long long value);
+void             telemetry_merge(TelemetryMetric *metric, const TelemetryHistogram *local);
+
+void             telemetry_histogram_reset(TelemetryHistogram *histogram);
+void             telemetry_histogram_observe(TelemetryHistogram *histogram,
+                                             unsigned long long value);
+
+int              telemetry_write_prometheus(TelemetryRegistry *registry, FILE *out);
+int              telemetry_write_jsonl(TelemetryRegistry *registry, FILE *out,
+                                       long long timestamp_ms);
+int              telemetry_export_file(TelemetryRegistry *registry, const char *path,
+                                       TelemetryFormat format);
+long long        telemetry_wall_clock_ms(void);
+
+#endif /* TELEMETRY_H */
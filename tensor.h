@@ -0,0 +1,89 @@
+/*
+===========================================================
+ Project:    Snake Game in Console
+ File:       tensor.h
+ Author:     Mobin Yousefi (GitHub: github.com/mobinyousefi-cs)
+ Created:    2026-10-19
+ Updated:    2026-10-19
+ License:    MIT License (see LICENSE file for details)
+===========================================================
+
+ Description:
+    Batched export of game states as float32 feature planes
+    for neural network training, written straight into a
+    caller-provided NCHW tensor.
+
+ Notes:
+    - Each frame is TENSOR_PLANES planes of height x width
+      floats, in TensorPlane order: body, head, food, then a
+      one-hot direction (the plane of the current direction
+      is all 1.0, the other three are all 0.0).
+    - A sample is `depth` frames stacked newest first, so it
+      has depth * TENSOR_PLANES channels. Sample i of a
+      batch starts at out + i * tensor_sample_floats().
+    - The body plane is converted a row at a time from the
+      dense grid (SSE2 when available, scalar otherwise);
+      sparse boards fall back to per-cell lookups. Walls and
+      exits are not part of the body plane.
+    - History stacking reads a TensorHistory ring that the
+      caller pushes once per tick. Frames older than the
+      ring holds are exported as zeros.
+    - All games of a batch must share the same board size.
+===========================================================
+*/
+
+#ifndef TENSOR_H
+#define TENSOR_H
+
+#include <stddef.h>
+
+#include "game.h"
+
+typedef enum TensorPlane {
+    TENSOR_BODY = 0,
+    TENSOR_HEAD,
+    TENSOR_FOOD,
+    TENSOR_DIR_UP,
+    TENSOR_DIR_DOWN,
+    TENSOR_DIR_LEFT,
+    TENSOR_DIR_RIGHT,
+    TENSOR_PLANES
+} TensorPlane;
+
+/* One recorded frame; body holds width x height CellKind bytes
+   in row-major order. */
+typedef struct TensorFrame {
+    unsigned char *body;
+    Position       head;
+    Position       food;
+    Direction      dir;
+} TensorFrame;
+
+typedef struct TensorHistory {
+    int            width;
+    int            height;
+    int            depth;
+    int            count;
+    int            newest;
+    TensorFrame   *frames;
+    unsigned char *storage;
+} TensorHistory;
+
+size_t         tensor_sample_floats(int width, int height, int depth);
+
+/* Exports the current state of `count` games as depth-1 samples.
+   Returns 0 if the batch is empty or the board sizes differ. */
+int            tensor_export(const Game *const *games, size_t count, float *out);
+
+TensorHistory *tensor_history_create(int width, int height, int depth);
+void           tensor_history_destroy(TensorHistory *history);
+void           tensor_history_reset(TensorHistory *history);
+int            tensor_history_push(TensorHistory *history, const Game *game);
+
+/* Exports `count` histories as samples of history->depth frames.
+   Returns 0 if the batch is empty or the histories differ in
+   size or depth. */
+int            tensor_export_history(const TensorHistory *const *histories, size_t count,
+                                      float *out);
+
+#endif /* TENSOR_H */
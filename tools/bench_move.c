@@ -0,0 +1,484 @@
+/*
+===========================================================
+ Project:    Snake Game in Console
+ File:       bench_move.c
+ Author:     Mobin Yousefi (GitHub: github.com/mobinyousefi-cs)
+ Created:    2026-10-19
+ Updated:    2026-10-19
+ License:    MIT License (see LICENSE file for details)
+===========================================================
+
+ Description:
+    Microbenchmark for the tick path. Plays the same steering
+    through the shipped game_change_direction() ->
+    snake_set_direction() and game_update() ->
+    snake_next_head_position() path, and through a verbatim
+    copy of the original game_update() (bounds check, then
+    the snake_occupies() walk), reporting ns per tick and,
+    on Linux, hardware branch misses. A third run adds the
+    session loop's telemetry to the shipped path, counting
+    every tick and timing the sampled ones, so telemetry
+    overhead is a figure.
+
+ Usage:
+    make -f Makefile.mak bench
+    ./bench_move [ticks]
+
+ Notes:
+    - The snake follows a Hamiltonian cycle, so it never
+      dies; a random half of the ticks also try to reverse,
+      which both paths must reject. A game is restarted once
+      the snake covers a quarter of the board, keeping the
+      original body walk at a realistic length.
+    - Restarts are not timed.
+===========================================================
+*/
+
+#define _POSIX_C_SOURCE 200809L
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "config.h"
+#include "game.h"
+#include "metrics.h"
+#include "utils.h"
+
+#ifdef __linux__
+#  include <linux/perf_event.h>
+#  include <sys/ioctl.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+#endif
+
+#define BENCH_WIDTH          40
+#define BENCH_HEIGHT         20
+#define BENCH_DEFAULT_TICKS  5000000L
+#define BENCH_NOISE_COUNT    4096
+#define BENCH_SEED           42
+
+typedef struct BenchResult {
+    long long ns;
+    long long branch_misses;
+    long long food;
+    long long restarts;
+} BenchResult;
+
+/* ---- Original path, kept verbatim for comparison ---- */
+
+typedef struct LegacyBoard {
+    int      width;
+    int      height;
+    Position food;
+} LegacyBoard;
+
+typedef struct LegacyGame {
+    LegacyBoard board;
+    Snake      *snake;
+    int         score;
+    GameStatus  status;
+} LegacyGame;
+
+static SnakeNode *legacy_allocate_node(int x, int y)
+{
+    SnakeNode *node = (SnakeNode *)malloc(sizeof(SnakeNode));
+    if (!node) {
+        return NULL;
+    }
+    node->pos.x = x;
+    node->pos.y = y;
+    node->next  = NULL;
+    return node;
+}
+
+static void legacy_set_direction(Snake *snake, Direction dir)
+{
+    if (!snake) {
+        return;
+    }
+
+    if ((snake->dir == DIR_UP && dir == DIR_DOWN) ||
+        (snake->dir == DIR_DOWN && dir == DIR_UP) ||
+        (snake->dir == DIR_LEFT && dir == DIR_RIGHT) ||
+        (snake->dir == DIR_RIGHT && dir == DIR_LEFT)) {
+        return;
+    }
+
+    snake->dir = dir;
+}
+
+static Position legacy_next_head_position(const Snake *snake)
+{
+    Position next = snake->head->pos;
+
+    switch (snake->dir) {
+    case DIR_UP:
+        next.y -= 1;
+        break;
+    case DIR_DOWN:
+        next.y += 1;
+        break;
+    case DIR_LEFT:
+        next.x -= 1;
+        break;
+    case DIR_RIGHT:
+        next.x += 1;
+        break;
+    }
+
+    return next;
+}
+
+static int legacy_snake_move(Snake *snake, int grow)
+{
+    if (!snake) {
+        return 0;
+    }
+
+    Position next = legacy_next_head_position(snake);
+
+    SnakeNode *new_head = legacy_allocate_node(next.x, next.y);
+    if (!new_head) {
+        return 0;
+    }
+
+    new_head->next = snake->head;
+    snake->head    = new_head;
+    snake->length++;
+
+    if (!grow) {
+        SnakeNode *prev = NULL;
+        SnakeNode *curr = snake->head;
+
+        while (curr->next) {
+            prev = curr;
+            curr = curr->next;
+        }
+
+        if (prev) {
+            prev->next = NULL;
+            snake->tail = prev;
+        } else {
+            snake->tail = snake->head;
+        }
+
+        free(curr);
+        snake->length--;
+    }
+
+    return 1;
+}
+
+static int legacy_board_is_inside(const LegacyBoard *board, int x, int y)
+{
+    if (!board) {
+        return 0;
+    }
+
+    return (x >= 0 && x < board->width && y >= 0 && y < board->height);
+}
+
+static void legacy_board_place_food(LegacyBoard *board, const Snake *snake)
+{
+    if (!board) {
+        return;
+    }
+
+    int x, y;
+
+    do {
+        x = rand() % board->width;
+        y = rand() % board->height;
+    } while (snake && snake_occupies(snake, x, y));
+
+    board->food.x = x;
+    board->food.y = y;
+}
+
+static void legacy_game_update(LegacyGame *game)
+{
+    if (!game || game->status != GAME_RUNNING) {
+        return;
+    }
+
+    Position next = legacy_next_head_position(game->snake);
+
+    if (!legacy_board_is_inside(&game->board, next.x, next.y)) {
+        game->status = GAME_OVER_COLLISION;
+        return;
+    }
+
+    if (snake_occupies(game->snake, next.x, next.y)) {
+        game->status = GAME_OVER_COLLISION;
+        return;
+    }
+
+    int grow = 0;
+    if (next.x == game->board.food.x && next.y == game->board.food.y) {
+        grow = 1;
+        game->score += 10;
+    }
+
+    if (!legacy_snake_move(game->snake, grow)) {
+        game->status = GAME_OVER_COLLISION;
+        return;
+    }
+
+    if (grow) {
+        legacy_board_place_food(&game->board, game->snake);
+    }
+}
+
+static int legacy_game_init(LegacyGame *game)
+{
+    game->board.width  = BENCH_WIDTH;
+    game->board.height = BENCH_HEIGHT;
+    game->snake        = snake_create(BENCH_WIDTH / 2, BENCH_HEIGHT / 2, DIR_RIGHT,
+                                      SNAKE_INITIAL_LENGTH);
+    game->score        = 0;
+    game->status       = GAME_RUNNING;
+    if (!game->snake) {
+        return 0;
+    }
+
+    legacy_board_place_food(&game->board, game->snake);
+    return 1;
+}
+
+/* ---- Steering ---- */
+
+/* Hamiltonian cycle on an even-height board: column 0 leads up,
+   even rows run right from x = 1, odd rows run left back to x = 1
+   and the last row on to column 0. The start row is even, with
+   the body trailing left, so a new game is already on the cycle. */
+static Direction cycle_direction(Position head)
+{
+    if (head.x == 0) {
+        return (head.y == 0) ? DIR_RIGHT : DIR_UP;
+    }
+    if (head.y % 2 == 0) {
+        return (head.x < BENCH_WIDTH - 1) ? DIR_RIGHT : DIR_DOWN;
+    }
+    if (head.y == BENCH_HEIGHT - 1 || head.x > 1) {
+        return DIR_LEFT;
+    }
+    return DIR_DOWN;
+}
+
+static int game_full(const Snake *snake)
+{
+    return snake->length >= BENCH_WIDTH * BENCH_HEIGHT / 4;
+}
+
+/* ---- Branch-miss counter ---- */
+
+static int open_branch_miss_counter(void)
+{
+#ifdef __linux__
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type           = PERF_TYPE_HARDWARE;
+    attr.size           = sizeof(attr);
+    attr.config         = PERF_COUNT_HW_BRANCH_MISSES;
+    attr.disabled       = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv     = 1;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+#else
+    return -1;
+#endif
+}
+
+static void counter_resume(int fd)
+{
+#ifdef __linux__
+    if (fd >= 0) {
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#else
+    (void)fd;
+#endif
+}
+
+static void counter_pause(int fd)
+{
+#ifdef __linux__
+    if (fd >= 0) {
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    }
+#else
+    (void)fd;
+#endif
+}
+
+static long long counter_take(int fd)
+{
+#ifdef __linux__
+    long long value = -1;
+    if (fd >= 0) {
+        if (read(fd, &value, sizeof(value)) != (ssize_t)sizeof(value)) {
+            value = -1;
+        }
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+    }
+    return value;
+#else
+    (void)fd;
+    return -1;
+#endif
+}
+
+/* ---- Runs ---- */
+
+/* With a report, each tick is also counted, and the sampled ones
+   timed and observed, the way the session loop does it, to
+   measure the telemetry's own cost. */
+static int run_shipped(const unsigned char *noise, long ticks, int counter,
+                       GameReport *report, BenchResult *result)
+{
+    memset(result, 0, sizeof(*result));
+    counter_take(counter);
+
+    long t = 0;
+    while (t < ticks) {
+        Game *game = game_create_ex(BENCH_WIDTH, BENCH_HEIGHT, BENCH_SEED + (uint64_t)result->restarts);
+        if (!game) {
+            return 0;
+        }
+
+        counter_resume(counter);
+        long long begin = utils_now_ns();
+
+        for (; t < ticks && !game_full(game->snake); ++t) {
+            if (noise[t & (BENCH_NOISE_COUNT - 1)]) {
+                game_change_direction(game, SNAKE_DIR_OPPOSITE[game->snake->dir]);
+            }
+            const int timing     = report && metrics_count_tick(report, 0);
+            long long tick_start = timing ? utils_now_ns() : 0;
+            game_change_direction(game, cycle_direction(game->snake->head->pos));
+            game_update(game);
+            if (timing) {
+                metrics_observe_tick(report, (unsigned long long)(utils_now_ns() - tick_start), 0);
+            }
+        }
+
+        result->ns += utils_now_ns() - begin;
+        counter_pause(counter);
+
+        result->food += game->stats.food_eaten;
+        result->restarts++;
+        int ok = (game->status == GAME_RUNNING);
+        game_destroy(game);
+        if (!ok) {
+            return 0;
+        }
+    }
+
+    result->branch_misses = counter_take(counter);
+    return 1;
+}
+
+static int run_legacy(const unsigned char *noise, long ticks, int counter, BenchResult *result)
+{
+    memset(result, 0, sizeof(*result));
+    counter_take(counter);
+    srand(BENCH_SEED);
+
+    long t = 0;
+    while (t < ticks) {
+        LegacyGame game;
+        if (!legacy_game_init(&game)) {
+            return 0;
+        }
+
+        counter_resume(counter);
+        long long begin = utils_now_ns();
+
+        for (; t < ticks && !game_full(game.snake); ++t) {
+            if (noise[t & (BENCH_NOISE_COUNT - 1)]) {
+                legacy_set_direction(game.snake, SNAKE_DIR_OPPOSITE[game.snake->dir]);
+            }
+            legacy_set_direction(game.snake, cycle_direction(game.snake->head->pos));
+            legacy_game_update(&game);
+        }
+
+        result->ns += utils_now_ns() - begin;
+        counter_pause(counter);
+
+        result->food += game.score / 10;
+        result->restarts++;
+        int ok = (game.status == GAME_RUNNING);
+        snake_destroy(game.snake);
+        if (!ok) {
+            return 0;
+        }
+    }
+
+    result->branch_misses = counter_take(counter);
+    return 1;
+}
+
+static void print_result(const char *name, const BenchResult *result, long ticks)
+{
+    printf("%-8s %8.3f ns/tick", name, (double)result->ns / (double)ticks);
+    if (result->branch_misses >= 0) {
+        printf("  %8.4f branch-misses/tick", (double)result->branch_misses / (double)ticks);
+    } else {
+        printf("  branch-misses n/a");
+    }
+    printf("  (%lld food, %lld games)\n", result->food, result->restarts);
+}
+
+int main(int argc, char **argv)
+{
+    long ticks = BENCH_DEFAULT_TICKS;
+
+    if (argc > 1 && (strcmp(argv[1], "--help") == 0 || strcmp(argv[1], "-h") == 0)) {
+        printf("Usage: %s [ticks]\n", argv[0]);
+        return EXIT_SUCCESS;
+    }
+    if (argc > 2 || (argc > 1 && !utils_parse_long(argv[1], 1, &ticks))) {
+        fprintf(stderr, "Usage: %s [ticks]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    unsigned char noise[BENCH_NOISE_COUNT];
+    uint64_t      state = utils_splitmix64(BENCH_SEED);
+    for (int i = 0; i < BENCH_NOISE_COUNT; ++i) {
+        noise[i] = (unsigned char)(utils_xorshift(&state) & 1u);
+    }
+
+    int         counter = open_branch_miss_counter();
+    BenchResult legacy;
+    BenchResult shipped;
+    BenchResult observed;
+    GameReport  report;
+
+    metrics_report_reset(&report);
+    metrics_report_sample(&report, METRICS_SAMPLE_EVERY);
+
+    if (!run_legacy(noise, ticks, counter, &legacy) ||
+        !run_shipped(noise, ticks, counter, NULL, &shipped) ||
+        !run_shipped(noise, ticks, counter, &report, &observed)) {
+        fprintf(stderr, "[ERROR] A benchmark game failed to start or left the cycle.\n");
+        return EXIT_FAILURE;
+    }
+
+    printf("Tick path, %ld ticks on a %dx%d board\n", ticks, BENCH_WIDTH, BENCH_HEIGHT);
+    print_result("legacy", &legacy, ticks);
+    print_result("shipped", &shipped, ticks);
+    print_result("+metrics", &observed, ticks);
+    printf("telemetry %+.3f ns/tick (%llu ticks counted, %llu timed)\n",
+           (double)(observed.ns - shipped.ns) / (double)ticks, report.tick_count,
+           report.tick_samples);
+
+#ifdef __linux__
+    if (counter >= 0) {
+        close(counter);
+    }
+#endif
+
+    return EXIT_SUCCESS;
+}
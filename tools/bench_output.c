@@ -0,0 +1,319 @@
+/*
+===========================================================
+ Project:    Snake Game in Console
+ File:       bench_output.c
+ Author:     Mobin Yousefi (GitHub: github.com/mobinyousefi-cs)
+ Created:    2026-10-19
+ Updated:    2026-10-19
+ License:    MIT License (see LICENSE file for details)
+===========================================================
+
+ Description:
+    Measures tick jitter for the three ways of presenting
+    frames: a blocking write per tick (game_render), the
+    non-blocking renderer, and the async writer thread.
+    stdout is redirected into a pipe that a reader thread
+    drains at a fixed byte rate, emulating a slow terminal,
+    while a bot plays at a fixed tick rate.
+
+ Usage:
+    make -f Makefile.mak bench
+    ./bench_output [--tick-ms N] [--seconds N] [--drain-kbps N]
+===========================================================
+*/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "config.h"
+#include "game.h"
+#include "policy.h"
+#include "render.h"
+#include "session.h"
+#include "utils.h"
+
+#define DRAIN_INTERVAL_MS  10
+
+typedef enum OutputMode {
+    OUTPUT_BLOCKING = 0,
+    OUTPUT_NONBLOCKING,
+    OUTPUT_ASYNC,
+    OUTPUT_COUNT
+} OutputMode;
+
+static const char *const MODE_NAMES[OUTPUT_COUNT] = {
+    "blocking", "nonblocking", "async"
+};
+
+typedef struct Drain {
+    int         fd;
+    long        bytes_per_interval;
+    atomic_int  stop;
+} Drain;
+
+typedef struct Result {
+    unsigned long long ticks;
+    long long          jitter_mean_ns;
+    long long          jitter_p99_ns;
+    long long          jitter_max_ns;
+    unsigned long long frames_dropped;
+} Result;
+
+/* Emulates a terminal that consumes output at a fixed rate. */
+static void *drain_main(void *arg)
+{
+    Drain *drain = (Drain *)arg;
+    char   chunk[4096];
+
+    struct timespec pause;
+    pause.tv_sec  = 0;
+    pause.tv_nsec = DRAIN_INTERVAL_MS * 1000000L;
+
+    while (!atomic_load(&drain->stop)) {
+        long budget = drain->bytes_per_interval;
+        while (budget > 0) {
+            size_t  want = (budget < (long)sizeof(chunk)) ? (size_t)budget : sizeof(chunk);
+            ssize_t n    = read(drain->fd, chunk, want);
+            if (n <= 0) {
+                return NULL;
+            }
+            budget -= (long)n;
+        }
+        nanosleep(&pause, NULL);
+    }
+
+    /* Unblock writers that are still flushing on shutdown. */
+    while (read(drain->fd, chunk, sizeof(chunk)) > 0) {
+    }
+    return NULL;
+}
+
+static void sleep_until(long long deadline_ns)
+{
+    long long now = utils_now_ns();
+    if (now >= deadline_ns) {
+        return;
+    }
+
+    struct timespec pause;
+    pause.tv_sec  = (time_t)((deadline_ns - now) / 1000000000LL);
+    pause.tv_nsec = (long)((deadline_ns - now) % 1000000000LL);
+    nanosleep(&pause, NULL);
+}
+
+static int compare_ll(const void *a, const void *b)
+{
+    long long x = *(const long long *)a;
+    long long y = *(const long long *)b;
+    return (x > y) - (x < y);
+}
+
+static int run_mode(OutputMode mode, long long tick_ns, long long duration_ns, Result *result)
+{
+    Renderer  renderer;
+    Renderer *presenter = NULL;
+
+    if (mode == OUTPUT_NONBLOCKING || mode == OUTPUT_ASYNC) {
+        int ready = (mode == OUTPUT_ASYNC) ? renderer_init_async(&renderer)
+                                           : renderer_init(&renderer);
+        if (!ready) {
+            return 0;
+        }
+        presenter = &renderer;
+    }
+
+    size_t     capacity = (size_t)(duration_ns / tick_ns) + 16;
+    long long *jitter   = (long long *)malloc(capacity * sizeof(long long));
+    Policy    *bot      = policy_create(POLICY_AUTOPILOT, 1);
+    if (!jitter || !bot) {
+        free(jitter);
+        policy_destroy(bot);
+        if (presenter) {
+            renderer_free(presenter);
+        }
+        return 0;
+    }
+
+    const long long start = utils_now_ns();
+    const long long stop  = start + duration_ns;
+    uint64_t        seed  = 1;
+    size_t          count = 0;
+
+    while (utils_now_ns() < stop && count < capacity) {
+        Game *game = game_create_ex(BOARD_WIDTH, BOARD_HEIGHT, seed++);
+        if (!game) {
+            break;
+        }
+
+        GameSession session;
+        session_init(&session, game, presenter, tick_ns, utils_now_ns());
+
+        while (count < capacity) {
+            unsigned long long before = session.report.tick_count;
+
+            if (session.phase == SESSION_WAIT) {
+                session_push_input(&session, session_turn_input(policy_choose(bot, game)));
+            }
+
+            long long deadline = session_pump(&session, utils_now_ns());
+
+            if (session.report.tick_count != before) {
+                jitter[count++] = session.tick_jitter_ns;
+                if (mode == OUTPUT_BLOCKING) {
+                    game_render(game);
+                }
+            }
+
+            if (deadline == SESSION_DONE || utils_now_ns() >= stop) {
+                break;
+            }
+
+            if (session_wants_output(&session)) {
+                long long now = utils_now_ns();
+                if (deadline > now) {
+                    utils_wait_stdout_writable((int)((deadline - now + 999999LL) / 1000000LL));
+                }
+            } else {
+                sleep_until(deadline);
+            }
+        }
+
+        game_destroy(game);
+    }
+
+    if (presenter) {
+        renderer_finish(presenter, utils_now_ns());
+        result->frames_dropped = presenter->stats.frames_dropped;
+        renderer_free(presenter);
+    } else {
+        result->frames_dropped = 0;
+    }
+
+    long long sum = 0;
+    for (size_t i = 0; i < count; ++i) {
+        sum += jitter[i];
+    }
+    qsort(jitter, count, sizeof(long long), compare_ll);
+
+    result->ticks          = count;
+    result->jitter_mean_ns = count ? sum / (long long)count : 0;
+    result->jitter_p99_ns  = count ? jitter[(count * 99) / 100] : 0;
+    result->jitter_max_ns  = count ? jitter[count - 1] : 0;
+
+    free(jitter);
+    policy_destroy(bot);
+    return 1;
+}
+
+/* Returns 1 to run, 0 on a bad option and -1 for --help. */
+static int parse_arguments(int argc, char **argv, long *tick_ms, long *seconds, long *drain_kbps)
+{
+    for (int i = 1; i < argc; ++i) {
+        const char *name  = argv[i];
+        const char *value = (i + 1 < argc) ? argv[i + 1] : NULL;
+        long        number;
+
+        if (strcmp(name, "--help") == 0 || strcmp(name, "-h") == 0) {
+            return -1;
+        }
+        if (!value) {
+            fprintf(stderr, "[ERROR] Option '%s' expects a value.\n", name);
+            return 0;
+        }
+
+        if (strcmp(name, "--tick-ms") == 0 && utils_parse_long(value, 1, &number)) {
+            *tick_ms = number;
+        } else if (strcmp(name, "--seconds") == 0 && utils_parse_long(value, 1, &number)) {
+            *seconds = number;
+        } else if (strcmp(name, "--drain-kbps") == 0 && utils_parse_long(value, 1, &number)) {
+            *drain_kbps = number;
+        } else {
+            fprintf(stderr, "[ERROR] Bad option or value: %s %s\n", name, value);
+            return 0;
+        }
+        ++i;
+    }
+
+    return 1;
+}
+
+int main(int argc, char **argv)
+{
+    long tick_ms    = 10;
+    long seconds    = 3;
+    long drain_kbps = 64;
+
+    int parsed = parse_arguments(argc, argv, &tick_ms, &seconds, &drain_kbps);
+    if (parsed <= 0) {
+        fprintf(parsed < 0 ? stdout : stderr,
+                "Usage: %s [--tick-ms N] [--seconds N] [--drain-kbps N]\n", argv[0]);
+        return parsed < 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    printf("tick %ld ms, %ld s per mode, terminal drains %ld KiB/s\n\n",
+           tick_ms, seconds, drain_kbps);
+    printf("%-12s %8s %12s %12s %12s %10s\n",
+           "mode", "ticks", "mean ms", "p99 ms", "max ms", "dropped");
+    fflush(stdout);
+
+    const int saved_stdout = dup(STDOUT_FILENO);
+    if (saved_stdout < 0) {
+        fprintf(stderr, "[ERROR] Failed to duplicate stdout.\n");
+        return EXIT_FAILURE;
+    }
+
+    for (int mode = 0; mode < OUTPUT_COUNT; ++mode) {
+        int pipe_fds[2];
+        if (pipe(pipe_fds) != 0) {
+            fprintf(stderr, "[ERROR] Failed to create pipe.\n");
+            return EXIT_FAILURE;
+        }
+
+        Drain drain;
+        drain.fd                 = pipe_fds[0];
+        drain.bytes_per_interval = drain_kbps * 1024 * DRAIN_INTERVAL_MS / 1000;
+        atomic_init(&drain.stop, 0);
+
+        pthread_t reader;
+        if (pthread_create(&reader, NULL, drain_main, &drain) != 0) {
+            fprintf(stderr, "[ERROR] Failed to start drain thread.\n");
+            return EXIT_FAILURE;
+        }
+
+        dup2(pipe_fds[1], STDOUT_FILENO);
+        close(pipe_fds[1]);
+
+        Result result;
+        int    ok = run_mode((OutputMode)mode, tick_ms * 1000000LL,
+                             seconds * 1000000000LL, &result);
+
+        /* Restoring stdout closes the last write end, so the drain
+           thread sees EOF once it has consumed the backlog. */
+        fflush(stdout);
+        dup2(saved_stdout, STDOUT_FILENO);
+        atomic_store(&drain.stop, 1);
+        pthread_join(reader, NULL);
+        close(pipe_fds[0]);
+
+        if (!ok) {
+            fprintf(stderr, "[ERROR] Failed to run mode '%s'.\n", MODE_NAMES[mode]);
+            return EXIT_FAILURE;
+        }
+
+        printf("%-12s %8llu %12.3f %12.3f %12.3f %10llu\n",
+               MODE_NAMES[mode], result.ticks,
+               (double)result.jitter_mean_ns / 1e6, (double)result.jitter_p99_ns / 1e6,
+               (double)result.jitter_max_ns / 1e6, result.frames_dropped);
+        fflush(stdout);
+    }
+
+    close(saved_stdout);
+    return EXIT_SUCCESS;
+}
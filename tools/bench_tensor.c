@@ -0,0 +1,186 @@
+/*
+===========================================================
+ Project:    Snake Game in Console
+ File:       bench_tensor.c
+ Author:     Mobin Yousefi (GitHub: github.com/mobinyousefi-cs)
+ Created:    2026-10-19
+ Updated:    2026-10-19
+ License:    MIT License (see LICENSE file for details)
+===========================================================
+
+ Description:
+    Benchmark for the feature-tensor export. Plays a batch
+    of games with the autopilot, then times exporting the
+    whole batch per cell (the cell_symbol() style lookup),
+    with tensor_export(), and with history stacking,
+    checking that the first two produce identical tensors.
+
+ Usage:
+    make -f Makefile.mak bench
+    ./bench_tensor [games] [rounds] [depth]
+===========================================================
+*/
+
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "tensor.h"
+#include "game.h"
+#include "policy.h"
+#include "utils.h"
+
+#define BENCH_WIDTH           40
+#define BENCH_HEIGHT          20
+#define BENCH_DEFAULT_GAMES   4096
+#define BENCH_DEFAULT_ROUNDS  50
+#define BENCH_DEFAULT_DEPTH   4
+#define BENCH_WARMUP_TICKS    200
+
+/* One frame per game through board_cell_at(), as a data loader
+   serializing boards cell by cell would do. */
+static void export_per_cell(const Game *const *games, size_t count, float *out)
+{
+    const size_t plane = (size_t)BENCH_WIDTH * BENCH_HEIGHT;
+
+    for (size_t i = 0; i < count; ++i) {
+        const Game  *game  = games[i];
+        const Board *board = game->board;
+        const Snake *snake = game->snake;
+        float       *dst   = out + i * plane * TENSOR_PLANES;
+
+        for (int y = 0; y < BENCH_HEIGHT; ++y) {
+            for (int x = 0; x < BENCH_WIDTH; ++x) {
+                size_t cell = (size_t)y * BENCH_WIDTH + (size_t)x;
+
+                dst[TENSOR_BODY * plane + cell] = board_cell_at(board, x, y) == CELL_BODY;
+                dst[TENSOR_HEAD * plane + cell] = snake->head->pos.x == x && snake->head->pos.y == y;
+                dst[TENSOR_FOOD * plane + cell] = board->food.x == x && board->food.y == y;
+                for (int d = 0; d < 4; ++d) {
+                    dst[(TENSOR_DIR_UP + d) * plane + cell] = (int)snake->dir == d;
+                }
+            }
+        }
+    }
+}
+
+static void print_result(const char *name, long long ns, int rounds, size_t games, size_t floats)
+{
+    double seconds = (double)ns / 1e9;
+    printf("%-10s %9.3f ms/batch  %8.2f M samples/s  %7.2f GB/s\n", name,
+           (double)ns / 1e6 / rounds, (double)games * rounds / seconds / 1e6,
+           (double)floats * sizeof(float) * rounds / seconds / 1e9);
+}
+
+int main(int argc, char **argv)
+{
+    long count    = BENCH_DEFAULT_GAMES;
+    long rounds_l = BENCH_DEFAULT_ROUNDS;
+    long depth_l  = BENCH_DEFAULT_DEPTH;
+
+    if (argc > 1 && (strcmp(argv[1], "--help") == 0 || strcmp(argv[1], "-h") == 0)) {
+        printf("Usage: %s [games] [rounds] [depth]\n", argv[0]);
+        return EXIT_SUCCESS;
+    }
+
+    if (argc > 4 ||
+        (argc > 1 && !utils_parse_long(argv[1], 1, &count)) ||
+        (argc > 2 && (!utils_parse_long(argv[2], 1, &rounds_l) || rounds_l > INT_MAX)) ||
+        (argc > 3 && (!utils_parse_long(argv[3], 1, &depth_l) || depth_l > INT_MAX))) {
+        fprintf(stderr, "Usage: %s [games] [rounds] [depth]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    const int rounds = (int)rounds_l;
+    const int depth  = (int)depth_l;
+
+    size_t          games_n   = (size_t)count;
+    Game          **games     = (Game **)calloc(games_n, sizeof(Game *));
+    TensorHistory **histories = (TensorHistory **)calloc(games_n, sizeof(TensorHistory *));
+    Policy         *policy    = policy_create(POLICY_AUTOPILOT, 7);
+    size_t          frame     = tensor_sample_floats(BENCH_WIDTH, BENCH_HEIGHT, 1);
+    size_t          stacked   = tensor_sample_floats(BENCH_WIDTH, BENCH_HEIGHT, depth);
+    float          *expected  = (float *)malloc(games_n * frame * sizeof(float));
+    float          *actual    = (float *)malloc(games_n * stacked * sizeof(float));
+    int             status    = EXIT_FAILURE;
+
+    if (!games || !histories || !policy || !expected || !actual) {
+        fprintf(stderr, "[ERROR] Out of memory.\n");
+        goto cleanup;
+    }
+
+    for (size_t i = 0; i < games_n; ++i) {
+        games[i]     = game_create_ex(BENCH_WIDTH, BENCH_HEIGHT, (uint64_t)i + 1);
+        histories[i] = tensor_history_create(BENCH_WIDTH, BENCH_HEIGHT, depth);
+        if (!games[i] || !histories[i]) {
+            fprintf(stderr, "[ERROR] Failed to create game %zu.\n", i);
+            goto cleanup;
+        }
+
+        /* Vary snake lengths across the batch; the history ring is
+           filled along the way like a trainer would. */
+        int warmup = (int)(i % BENCH_WARMUP_TICKS);
+        for (int t = 0; t < warmup && games[i]->status == GAME_RUNNING; ++t) {
+            game_change_direction(games[i], policy_choose(policy, games[i]));
+            game_update(games[i]);
+            tensor_history_push(histories[i], games[i]);
+        }
+        tensor_history_push(histories[i], games[i]);
+    }
+
+    const Game *const          *batch = (const Game *const *)games;
+    const TensorHistory *const *ring  = (const TensorHistory *const *)histories;
+
+    long long begin = utils_now_ns();
+    for (int r = 0; r < rounds; ++r) {
+        export_per_cell(batch, games_n, expected);
+    }
+    long long per_cell = utils_now_ns() - begin;
+
+    begin = utils_now_ns();
+    for (int r = 0; r < rounds; ++r) {
+        tensor_export(batch, games_n, actual);
+    }
+    long long vectorized = utils_now_ns() - begin;
+
+    if (memcmp(expected, actual, games_n * frame * sizeof(float)) != 0) {
+        fprintf(stderr, "[ERROR] tensor_export() disagrees with the per-cell export.\n");
+        goto cleanup;
+    }
+
+    begin = utils_now_ns();
+    for (int r = 0; r < rounds; ++r) {
+        tensor_export_history(ring, games_n, actual);
+    }
+    long long history = utils_now_ns() - begin;
+
+    printf("Feature export, %zu games of %dx%d, %d rounds (%s)\n", games_n, BENCH_WIDTH,
+           BENCH_HEIGHT, rounds,
+#ifdef __SSE2__
+           "SSE2"
+#else
+           "scalar"
+#endif
+           );
+    print_result("per-cell", per_cell, rounds, games_n, games_n * frame);
+    print_result("export", vectorized, rounds, games_n, games_n * frame);
+    printf("history depth %d:\n", depth);
+    print_result("export", history, rounds, games_n, games_n * stacked);
+
+    status = EXIT_SUCCESS;
+
+cleanup:
+    for (size_t i = 0; games && i < games_n; ++i) {
+        game_destroy(games[i]);
+    }
+    for (size_t i = 0; histories && i < games_n; ++i) {
+        tensor_history_destroy(histories[i]);
+    }
+    free(games);
+    free(histories);
+    free(expected);
+    free(actual);
+    policy_destroy(policy);
+    return status;
+}
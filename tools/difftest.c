@@ -0,0 +1,1259 @@
+/*
+===========================================================
+ Project:    Snake Game in Console
+ File:       difftest.c
+ Author:     Mobin Yousefi (GitHub: github.com/mobinyousefi-cs)
+ Created:    2026-10-19
+ Updated:    2026-10-19
+ License:    MIT License (see LICENSE file for details)
+===========================================================
+
+ Description:
+    Differential fuzzing harness. A reference model built
+    only on the linked-list snake (snake_occupies() for
+    every collision, no board, and the original switch
+    based steering rather than the SNAKE_DIR_* tables the
+    engine shares) is stepped in lockstep with
+    each engine path on the same seed and inputs, and the
+    full state is compared after every tick. A divergence
+    is shrunk to a minimal replay and written to a file.
+
+ Usage:
+    make -f Makefile.mak difftest
+    ./difftest [--cases N] [--seconds N] [--threads N]
+               [--seed N] [--max-size WxH] [--max-ticks N]
+               [--deep-every N] [--lanes dense,sparse,reach]
+               [--tensor on|off] [--out PATH]
+    ./difftest --replay PATH
+
+ Notes:
+    - Lanes: "dense" is game_update() on the padded grid,
+      "sparse" the same game on a chunked board, and "reach"
+      a dense game with reachable-area tracking enabled. New
+      backends are added as rows of the LANES table.
+    - Every tick compares status, counters, score, food,
+      direction, head, tail and length. Every --deep-every
+      ticks (further apart on big boards; 0 for game end
+      only) and at game end, the body is also compared node
+      by node, each lane's board cell by cell, the reach
+      lane's move areas against a flood fill, and
+      tensor_export() of the dense and sparse lanes against
+      planes built from the reference.
+    - One case in LARGE_CASE_EVERY uses a board spanning
+      several sparse chunks.
+    - Inputs are one character per tick: U D L R, '.' for
+      no key, 'x' for an out-of-range direction. A replay
+      file holds one line: "WxH SEED INPUTS".
+    - --cases 0 runs until --seconds have elapsed, for
+      overnight runs on every core.
+    - Built with -DSNAKE_LIBFUZZER the file provides
+      LLVMFuzzerTestOneInput() instead of main(); see the
+      fuzz_difftest target in the Makefile.
+===========================================================
+*/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <limits.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "config.h"
+#include "game.h"
+#include "pool.h"
+#include "snake.h"
+#include "tensor.h"
+#include "utils.h"
+
+#define DEFAULT_CASES         100000L
+#define DEFAULT_MAX_WIDTH     32
+#define DEFAULT_MAX_HEIGHT    24
+#define DEFAULT_MAX_TICKS     20000L
+#define DEFAULT_DEEP_EVERY    64L
+#define DEFAULT_OUT           "difftest.replay"
+#define CASES_PER_TASK        64
+#define LARGE_CASE_EVERY      8
+#define LARGE_CASE_SIZE       (2 * BOARD_CHUNK_SIZE + 16)
+#define DEEP_CELLS_PER_TICK   16
+#define MIN_WIDTH             (2 * (SNAKE_INITIAL_LENGTH - 1))
+#define MESSAGE_SIZE          160
+
+#define INPUT_NONE            '.'
+#define INPUT_INVALID         'x'
+
+typedef enum Lane {
+    LANE_DENSE = 0,
+    LANE_SPARSE,
+    LANE_REACH,
+    LANE_COUNT
+} Lane;
+
+typedef struct LaneInfo {
+    const char *name;
+    Game     *(*create)(int width, int height, uint64_t seed);
+    int         reach;
+    int         tensor;
+} LaneInfo;
+
+static const LaneInfo LANES[LANE_COUNT] = {
+    { "dense",  game_create_ex,     0, 1 },
+    { "sparse", game_create_sparse, 0, 1 },
+    { "reach",  game_create_ex,     1, 0 },
+};
+
+/* ---- Reference model ---- */
+
+typedef struct RefGame {
+    int        width;
+    int        height;
+    Snake     *snake;
+    Position   food;
+    uint64_t   rng_state;
+    int        score;
+    GameStatus status;
+    GameStats  stats;
+} RefGame;
+
+static uint64_t ref_random(RefGame *ref)
+{
+    return utils_xorshift(&ref->rng_state);
+}
+
+/* Steering is a verbatim copy of the original switch and comparison
+   chain, not the SNAKE_DIR_* tables, which also drive board->step
+   and every engine lane: a wrong table entry must show up as a
+   divergence rather than move both sides the same way. */
+static void ref_set_direction(Snake *snake, Direction dir)
+{
+    /* The original accepted any value here; out-of-range keys are
+       ignored by every path now, so the reference does the same. */
+    if ((unsigned)dir > DIR_RIGHT) {
+        return;
+    }
+
+    if ((snake->dir == DIR_UP && dir == DIR_DOWN) ||
+        (snake->dir == DIR_DOWN && dir == DIR_UP) ||
+        (snake->dir == DIR_LEFT && dir == DIR_RIGHT) ||
+        (snake->dir == DIR_RIGHT && dir == DIR_LEFT)) {
+        return;
+    }
+
+    snake->dir = dir;
+}
+
+static Position ref_next_head_position(const Snake *snake)
+{
+    Position next = snake->head->pos;
+
+    switch (snake->dir) {
+    case DIR_UP:
+        next.y -= 1;
+        break;
+    case DIR_DOWN:
+        next.y += 1;
+        break;
+    case DIR_LEFT:
+        next.x -= 1;
+        break;
+    case DIR_RIGHT:
+        next.x += 1;
+        break;
+    }
+
+    return next;
+}
+
+/* snake_move() with the original head computation and tail walk. */
+static int ref_snake_move(Snake *snake, int grow)
+{
+    Position next = ref_next_head_position(snake);
+
+    SnakeNode *new_head = (SnakeNode *)malloc(sizeof(SnakeNode));
+    if (!new_head) {
+        return 0;
+    }
+    new_head->pos  = next;
+    new_head->next = snake->head;
+    snake->head    = new_head;
+    snake->length++;
+
+    if (!grow) {
+        SnakeNode *prev = NULL;
+        SnakeNode *curr = snake->head;
+
+        while (curr->next) {
+            prev = curr;
+            curr = curr->next;
+        }
+
+        if (prev) {
+            prev->next = NULL;
+            snake->tail = prev;
+        } else {
+            snake->tail = snake->head;
+        }
+
+        free(curr);
+        snake->length--;
+    }
+
+    return 1;
+}
+
+static int ref_inside(const RefGame *ref, int x, int y)
+{
+    return x >= 0 && x < ref->width && y >= 0 && y < ref->height;
+}
+
+static int ref_free(const RefGame *ref, int x, int y)
+{
+    return ref_inside(ref, x, y) && !snake_occupies(ref->snake, x, y);
+}
+
+static void ref_place_food(RefGame *ref)
+{
+    for (int i = 0; i < BOARD_FOOD_RANDOM_ATTEMPTS; ++i) {
+        int x = (int)(ref_random(ref) % (uint64_t)ref->width);
+        int y = (int)(ref_random(ref) % (uint64_t)ref->height);
+
+        if (ref_free(ref, x, y)) {
+            ref->food.x = x;
+            ref->food.y = y;
+            return;
+        }
+    }
+
+    long long total = (long long)ref->width * ref->height;
+    long long start = (long long)(ref_random(ref) % (uint64_t)total);
+
+    for (long long i = 0; i < total; ++i) {
+        long long cell = (start + i) % total;
+        int       x    = (int)(cell % ref->width);
+        int       y    = (int)(cell / ref->width);
+
+        if (ref_free(ref, x, y)) {
+            ref->food.x = x;
+            ref->food.y = y;
+            return;
+        }
+    }
+}
+
+static int ref_init(RefGame *ref, int width, int height, uint64_t seed)
+{
+    memset(ref, 0, sizeof(*ref));
+    ref->width  = width;
+    ref->height = height;
+    ref->food.x = width / 2;
+    ref->food.y = height / 2;
+    ref->snake  = snake_create(width / 2, height / 2, DIR_RIGHT, SNAKE_INITIAL_LENGTH);
+    if (!ref->snake) {
+        return 0;
+    }
+
+    ref->rng_state = utils_splitmix64(seed);
+
+    ref->status = GAME_RUNNING;
+    ref_place_food(ref);
+    return 1;
+}
+
+static void ref_update(RefGame *ref)
+{
+    if (ref->status != GAME_RUNNING) {
+        return;
+    }
+
+    const Position next = ref_next_head_position(ref->snake);
+
+    ref->stats.ticks++;
+
+    if (!ref_inside(ref, next.x, next.y)) {
+        ref->status      = GAME_OVER_COLLISION;
+        ref->stats.death = DEATH_WALL;
+        return;
+    }
+    if (snake_occupies(ref->snake, next.x, next.y)) {
+        ref->status      = GAME_OVER_COLLISION;
+        ref->stats.death = DEATH_SELF;
+        return;
+    }
+
+    int grow = (next.x == ref->food.x && next.y == ref->food.y);
+    if (grow) {
+        ref->score += 10;
+        ref->stats.food_eaten++;
+    }
+
+    if (!ref_snake_move(ref->snake, grow)) {
+        ref->status = GAME_OVER_COLLISION;
+        return;
+    }
+    if (grow) {
+        ref_place_food(ref);
+    }
+}
+
+/* Returns 0 for "no key". INPUT_INVALID maps to a value past
+   DIR_RIGHT, which every path must ignore. */
+static int input_direction(char input, Direction *dir)
+{
+    switch (input) {
+    case 'U':
+        *dir = DIR_UP;
+        return 1;
+    case 'D':
+        *dir = DIR_DOWN;
+        return 1;
+    case 'L':
+        *dir = DIR_LEFT;
+        return 1;
+    case 'R':
+        *dir = DIR_RIGHT;
+        return 1;
+    case INPUT_INVALID:
+        *dir = (Direction)(DIR_RIGHT + 1);
+        return 1;
+    default:
+        return 0;
+    }
+}
+
+/* ---- Lockstep runner ---- */
+
+typedef struct Scratch {
+    size_t         cells;
+    int            stride;
+    unsigned char *grid;
+    unsigned int  *seen;
+    unsigned int   epoch;
+    int           *queue;
+    float         *expected;
+    float         *actual;
+} Scratch;
+
+typedef struct Divergence {
+    int                found;
+    int                lane;
+    unsigned long long tick;
+    char               what[MESSAGE_SIZE];
+} Divergence;
+
+typedef struct CaseSpec {
+    int      width;
+    int      height;
+    uint64_t seed;
+} CaseSpec;
+
+typedef struct RunConfig {
+    int  lanes[LANE_COUNT];
+    int  tensor;
+    long deep_every;
+} RunConfig;
+
+/* Picks each tick's input while a case is generated. */
+typedef struct InputSource {
+    uint64_t state;
+    int      cautious;
+} InputSource;
+
+static void scratch_free(Scratch *scratch)
+{
+    free(scratch->grid);
+    free(scratch->seen);
+    free(scratch->queue);
+    free(scratch->expected);
+    free(scratch->actual);
+    memset(scratch, 0, sizeof(*scratch));
+}
+
+static int scratch_reserve(Scratch *scratch, int width, int height)
+{
+    size_t cells = (size_t)(width + 2) * (size_t)(height + 2);
+    if (cells <= scratch->cells) {
+        return 1;
+    }
+
+    scratch_free(scratch);
+    scratch->cells    = cells;
+    scratch->grid     = (unsigned char *)malloc(cells);
+    scratch->seen     = (unsigned int *)calloc(cells, sizeof(unsigned int));
+    scratch->queue    = (int *)malloc(cells * sizeof(int));
+    scratch->expected = (float *)malloc(TENSOR_PLANES * cells * sizeof(float));
+    scratch->actual   = (float *)malloc(TENSOR_PLANES * cells * sizeof(float));
+
+    if (!scratch->grid || !scratch->seen || !scratch->queue ||
+        !scratch->expected || !scratch->actual) {
+        scratch_free(scratch);
+        return 0;
+    }
+    return 1;
+}
+
+/* Deep checks cost O(cells); on big boards they are spaced out so
+   they stay a bounded share of the run. */
+static long deep_interval(const CaseSpec *spec, long every)
+{
+    long spaced = (long)spec->width * spec->height / DEEP_CELLS_PER_TICK;
+    return (every > 0 && spaced > every) ? spaced : every;
+}
+
+static void diverge(Divergence *div, int lane, unsigned long long tick, const char *what)
+{
+    div->found = 1;
+    div->lane  = lane;
+    div->tick  = tick;
+    snprintf(div->what, sizeof(div->what), "%s", what);
+}
+
+static int grid_index(const Scratch *scratch, int x, int y)
+{
+    return (y + 1) * scratch->stride + (x + 1);
+}
+
+/* Reference occupancy on a grid padded by one occupied cell on
+   every side, so the flood fill needs no bounds checks. */
+static void fill_grid(const RefGame *ref, Scratch *scratch)
+{
+    scratch->stride = ref->width + 2;
+    memset(scratch->grid, 1, (size_t)scratch->stride * (size_t)(ref->height + 2));
+    for (int y = 0; y < ref->height; ++y) {
+        memset(scratch->grid + grid_index(scratch, 0, y), 0, (size_t)ref->width);
+    }
+    for (const SnakeNode *node = ref->snake->head; node; node = node->next) {
+        scratch->grid[grid_index(scratch, node->pos.x, node->pos.y)] = 1;
+    }
+}
+
+/* Free cells reachable from the head after moving in `dir`, by
+   flood fill over the reference grid; the tail cell is free unless
+   the move eats. Expects fill_grid() to be current. */
+static int ref_move_area(const RefGame *ref, Scratch *scratch, Direction dir)
+{
+    Snake probe = *ref->snake;
+    probe.dir   = dir;
+
+    const Position next   = ref_next_head_position(&probe);
+    const Position tail   = ref->snake->tail->pos;
+    const int      nx     = next.x;
+    const int      ny     = next.y;
+    const int      start  = grid_index(scratch, nx, ny);
+    const int      last   = grid_index(scratch, tail.x, tail.y);
+    const int      step[4] = { -scratch->stride, scratch->stride, -1, 1 };
+    unsigned char *grid   = scratch->grid;
+
+    if (grid[start]) {
+        return 0;
+    }
+
+    const int eats = (nx == ref->food.x && ny == ref->food.y);
+    if (!eats) {
+        grid[last] = 0;
+    }
+    grid[start] = 1;
+
+    if (++scratch->epoch == 0) {
+        memset(scratch->seen, 0, scratch->cells * sizeof(unsigned int));
+        scratch->epoch = 1;
+    }
+
+    const unsigned int epoch      = scratch->epoch;
+    int                head_count = 0;
+    int                tail_count = 0;
+
+    scratch->queue[tail_count++] = start;
+    scratch->seen[start]         = epoch;
+
+    while (head_count < tail_count) {
+        int cell = scratch->queue[head_count++];
+
+        for (int d = 0; d < 4; ++d) {
+            int c = cell + step[d];
+            if (!grid[c] && scratch->seen[c] != epoch) {
+                scratch->seen[c]             = epoch;
+                scratch->queue[tail_count++] = c;
+            }
+        }
+    }
+
+    grid[start] = 0;
+    if (!eats) {
+        grid[last] = 1;
+    }
+    return tail_count - 1;
+}
+
+static void ref_planes(const RefGame *ref, const Scratch *scratch)
+{
+    const size_t plane = (size_t)ref->width * (size_t)ref->height;
+    float       *out   = scratch->expected;
+
+    memset(out, 0, TENSOR_PLANES * plane * sizeof(float));
+    for (int y = 0; y < ref->height; ++y) {
+        for (int x = 0; x < ref->width; ++x) {
+            size_t i = (size_t)y * (size_t)ref->width + (size_t)x;
+            out[TENSOR_BODY * plane + i] = scratch->grid[grid_index(scratch, x, y)] ? 1.0f : 0.0f;
+        }
+    }
+    for (size_t i = 0; i < plane; ++i) {
+        out[(TENSOR_DIR_UP + ref->snake->dir) * plane + i] = 1.0f;
+    }
+
+    const Position head = ref->snake->head->pos;
+    out[TENSOR_HEAD * plane + (size_t)head.y * (size_t)ref->width + (size_t)head.x] = 1.0f;
+    out[TENSOR_FOOD * plane + (size_t)ref->food.y * (size_t)ref->width + (size_t)ref->food.x] = 1.0f;
+}
+
+/* Cheap per-tick comparison; writes a message and returns 0 on the
+   first difference. The body is the last `length` head positions,
+   so once it matched at tick 0, equal heads and lengths on every
+   tick keep it equal; the node-by-node walk runs in deep checks. */
+static int compare_state(const RefGame *ref, const Game *game, char *what)
+{
+    if (game->status != ref->status) {
+        snprintf(what, MESSAGE_SIZE, "status %d, reference %d", (int)game->status, (int)ref->status);
+        return 0;
+    }
+    if (game->stats.ticks != ref->stats.ticks || game->stats.food_eaten != ref->stats.food_eaten ||
+        game->stats.death != ref->stats.death || game->score != ref->score) {
+        snprintf(what, MESSAGE_SIZE, "counters ticks=%llu food=%lu death=%d score=%d, "
+                 "reference ticks=%llu food=%lu death=%d score=%d",
+                 game->stats.ticks, game->stats.food_eaten, (int)game->stats.death, game->score,
+                 ref->stats.ticks, ref->stats.food_eaten, (int)ref->stats.death, ref->score);
+        return 0;
+    }
+    if (game->board->food.x != ref->food.x || game->board->food.y != ref->food.y) {
+        snprintf(what, MESSAGE_SIZE, "food (%d,%d), reference (%d,%d)", game->board->food.x,
+                 game->board->food.y, ref->food.x, ref->food.y);
+        return 0;
+    }
+    if (game->snake->dir != ref->snake->dir || game->snake->length != ref->snake->length) {
+        snprintf(what, MESSAGE_SIZE, "dir %d length %d, reference dir %d length %d",
+                 (int)game->snake->dir, game->snake->length, (int)ref->snake->dir,
+                 ref->snake->length);
+        return 0;
+    }
+
+    const Position head = game->snake->head->pos;
+    const Position tail = game->snake->tail->pos;
+    const Position want = ref->snake->head->pos;
+    const Position last = ref->snake->tail->pos;
+
+    if (head.x != want.x || head.y != want.y || tail.x != last.x || tail.y != last.y) {
+        snprintf(what, MESSAGE_SIZE, "head (%d,%d) tail (%d,%d), reference head (%d,%d) tail (%d,%d)",
+                 head.x, head.y, tail.x, tail.y, want.x, want.y, last.x, last.y);
+        return 0;
+    }
+    if (game->status == GAME_RUNNING && board_cell_at(game->board, head.x, head.y) != CELL_BODY) {
+        snprintf(what, MESSAGE_SIZE, "head cell (%d,%d) not occupied on the board", head.x, head.y);
+        return 0;
+    }
+    return 1;
+}
+
+static int compare_body(const RefGame *ref, const Game *game, char *what)
+{
+    const SnakeNode *a = game->snake->head;
+    const SnakeNode *b = ref->snake->head;
+
+    for (int i = 0; a && b; a = a->next, b = b->next, ++i) {
+        if (a->pos.x != b->pos.x || a->pos.y != b->pos.y) {
+            snprintf(what, MESSAGE_SIZE, "body node %d at (%d,%d), reference (%d,%d)",
+                     i, a->pos.x, a->pos.y, b->pos.x, b->pos.y);
+            return 0;
+        }
+    }
+    if (a || b) {
+        snprintf(what, MESSAGE_SIZE, "body list length differs from its length field");
+        return 0;
+    }
+    return 1;
+}
+
+/* Full comparison of boards, move areas and tensors. Expects
+   fill_grid() to be current. */
+static int compare_deep(const RefGame *ref, const Game *game, const LaneInfo *lane,
+                        const RunConfig *config, Scratch *scratch, char *what)
+{
+    const Board *board = game->board;
+
+    if (!compare_body(ref, game, what)) {
+        return 0;
+    }
+
+    for (int y = 0; y < ref->height; ++y) {
+        const unsigned char *row = board->cells ? board->cells + board_cell_index(board, 0, y) : NULL;
+
+        for (int x = 0; x < ref->width; ++x) {
+            CellKind want = scratch->grid[grid_index(scratch, x, y)] ? CELL_BODY : CELL_EMPTY;
+            CellKind have = row ? (CellKind)row[x] : board_cell_at(board, x, y);
+            if (have != want) {
+                snprintf(what, MESSAGE_SIZE, "board cell (%d,%d) is %d, reference %d",
+                         x, y, (int)have, (int)want);
+                return 0;
+            }
+        }
+    }
+
+    if (lane->reach && ref->status == GAME_RUNNING) {
+        for (int d = 0; d < 4; ++d) {
+            int have = game_move_area(game, (Direction)d);
+            int want = ref_move_area(ref, scratch, (Direction)d);
+            if (have != want) {
+                snprintf(what, MESSAGE_SIZE, "move area %d for direction %d, flood fill %d",
+                         have, d, want);
+                return 0;
+            }
+        }
+    }
+
+    if (lane->tensor && config->tensor) {
+        const Game  *batch[1] = { game };
+        const size_t floats   = tensor_sample_floats(ref->width, ref->height, 1);
+
+        ref_planes(ref, scratch);
+        if (!tensor_export(batch, 1, scratch->actual) ||
+            memcmp(scratch->actual, scratch->expected, floats * sizeof(float)) != 0) {
+            snprintf(what, MESSAGE_SIZE, "tensor_export() differs from reference planes");
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static const char INPUT_KEYS[4] = { 'U', 'D', 'L', 'R' };
+
+/* Random keys, or in cautious cases mostly keys that do not kill
+   the snake at once, so boards fill up and reach the crowded food
+   placement path. */
+static char next_input(InputSource *source, const RefGame *ref)
+{
+    uint64_t r = utils_xorshift(&source->state);
+
+    if (r % 64 == 0) {
+        return INPUT_INVALID;
+    }
+
+    if (source->cautious && r % 16 != 1) {
+        const Position head = ref->snake->head->pos;
+        int            safe[4];
+        int            count = 0;
+
+        for (int d = 0; d < 4; ++d) {
+            if (ref_free(ref, head.x + SNAKE_DIR_DX[d], head.y + SNAKE_DIR_DY[d])) {
+                safe[count++] = d;
+            }
+        }
+        if (count > 0) {
+            int keep = ref->snake->dir;
+            for (int i = 0; i < count; ++i) {
+                if (safe[i] == keep && (r >> 8) % 4 != 0) {
+                    return INPUT_NONE;
+                }
+            }
+            return INPUT_KEYS[safe[(r >> 16) % (uint64_t)count]];
+        }
+    }
+
+    return ((r >> 8) % 3 == 0) ? INPUT_KEYS[(r >> 16) % 4] : INPUT_NONE;
+}
+
+/* Runs one case. With a source, inputs are generated and recorded
+   into `inputs` (capacity `count`); without one, `inputs` is
+   replayed. Returns the number of ticks run. */
+static size_t run_case(const CaseSpec *spec, const RunConfig *config, Scratch *scratch,
+                       char *inputs, size_t count, InputSource *source, Divergence *div)
+{
+    Game   *games[LANE_COUNT] = { NULL };
+    RefGame ref;
+    char    what[MESSAGE_SIZE];
+    size_t  tick = 0;
+
+    div->found = 0;
+
+    if (!scratch_reserve(scratch, spec->width, spec->height) ||
+        !ref_init(&ref, spec->width, spec->height, spec->seed)) {
+        diverge(div, -1, 0, "out of memory");
+        return 0;
+    }
+
+    for (int l = 0; l < LANE_COUNT; ++l) {
+        if (!config->lanes[l]) {
+            continue;
+        }
+        games[l] = LANES[l].create(spec->width, spec->height, spec->seed);
+        if (!games[l] || (LANES[l].reach && !game_enable_reach(games[l]))) {
+            diverge(div, l, 0, "lane could not be created");
+            goto done;
+        }
+    }
+
+    for (;;) {
+        int deep = (ref.status != GAME_RUNNING || tick == count ||
+                    (config->deep_every > 0 && tick % (size_t)config->deep_every == 0));
+        if (deep) {
+            fill_grid(&ref, scratch);
+        }
+
+        for (int l = 0; l < LANE_COUNT; ++l) {
+            if (games[l] && (!compare_state(&ref, games[l], what) ||
+                             (deep && !compare_deep(&ref, games[l], &LANES[l], config,
+                                                    scratch, what)))) {
+                diverge(div, l, tick, what);
+                goto done;
+            }
+        }
+
+        if (ref.status != GAME_RUNNING || tick == count) {
+            break;
+        }
+
+        if (source) {
+            inputs[tick] = next_input(source, &ref);
+        }
+        Direction dir;
+        int       pressed = input_direction(inputs[tick++], &dir);
+
+        if (pressed) {
+            ref_set_direction(ref.snake, dir);
+        }
+        ref_update(&ref);
+
+        for (int l = 0; l < LANE_COUNT; ++l) {
+            if (games[l]) {
+                if (pressed) {
+                    game_change_direction(games[l], dir);
+                }
+                game_update(games[l]);
+            }
+        }
+    }
+
+done:
+    for (int l = 0; l < LANE_COUNT; ++l) {
+        game_destroy(games[l]);
+    }
+    snake_destroy(ref.snake);
+    return tick;
+}
+
+/* ---- Replays ---- */
+
+typedef struct Replay {
+    CaseSpec spec;
+    char    *inputs;
+    size_t   count;
+} Replay;
+
+static int still_diverges(const Replay *replay, const RunConfig *config, Scratch *scratch,
+                          int lane, Divergence *div)
+{
+    run_case(&replay->spec, config, scratch, replay->inputs, replay->count, NULL, div);
+    return div->found && div->lane == lane;
+}
+
+/* Delta-debugging style shrink: drop chunks of inputs, or blank
+   them to '.', keeping any change after which the same lane still
+   diverges, with chunk sizes halving down to one input. Deep checks
+   run every tick here, so the replay ends at the first bad tick. */
+static void minimize(Replay *replay, const RunConfig *run, Scratch *scratch, Divergence *div)
+{
+    RunConfig  config = *run;
+    Divergence trial;
+    char      *saved  = (char *)malloc(replay->count + 1);
+
+    if (!saved) {
+        return;
+    }
+
+    config.deep_every = 1;
+    if (still_diverges(replay, &config, scratch, div->lane, &trial)) {
+        *div = trial;
+    }
+
+    const int lane = div->lane;
+    replay->count  = (size_t)div->tick;
+
+    for (size_t chunk = replay->count / 2; chunk >= 1; chunk /= 2) {
+        for (size_t start = 0; start + chunk <= replay->count;) {
+            size_t count = replay->count;
+            memcpy(saved, replay->inputs, count);
+
+            memmove(replay->inputs + start, replay->inputs + start + chunk, count - start - chunk);
+            replay->count = count - chunk;
+            if (still_diverges(replay, &config, scratch, lane, &trial)) {
+                *div          = trial;
+                replay->count = (size_t)trial.tick;
+                continue;
+            }
+
+            memcpy(replay->inputs, saved, count);
+            replay->count = count;
+
+            int blank = 0;
+            for (size_t i = start; i < start + chunk; ++i) {
+                blank |= (replay->inputs[i] != INPUT_NONE);
+                replay->inputs[i] = INPUT_NONE;
+            }
+            if (blank && still_diverges(replay, &config, scratch, lane, &trial)) {
+                *div          = trial;
+                replay->count = (size_t)trial.tick;
+            } else {
+                memcpy(replay->inputs, saved, count);
+            }
+            start += chunk;
+        }
+    }
+
+    free(saved);
+}
+
+static void print_replay(FILE *out, const Replay *replay)
+{
+    fprintf(out, "%dx%d %llu %.*s\n", replay->spec.width, replay->spec.height,
+            (unsigned long long)replay->spec.seed, (int)replay->count,
+            replay->count ? replay->inputs : "-");
+}
+
+static void report_divergence(const Replay *replay, const Divergence *div, const char *path)
+{
+    fprintf(stderr, "[ERROR] Divergence in lane '%s' after tick %llu: %s\n",
+            div->lane >= 0 ? LANES[div->lane].name : "?", div->tick, div->what);
+    fprintf(stderr, "Replay (%zu inputs): ", replay->count);
+    print_replay(stderr, replay);
+
+    FILE *out = path ? fopen(path, "w") : NULL;
+    if (out) {
+        print_replay(out, replay);
+        fclose(out);
+        fprintf(stderr, "Written to %s; rerun with --replay %s\n", path, path);
+    }
+}
+
+#ifdef SNAKE_LIBFUZZER
+
+/* Input bytes: width, height, four seed bytes, then one key per
+   byte. Any divergence aborts after printing its replay. */
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    static Scratch    scratch;
+    static const char KEYS[8] = { 'U', 'D', 'L', 'R', INPUT_INVALID, '.', '.', '.' };
+
+    if (size < 6) {
+        return 0;
+    }
+
+    RunConfig config;
+    for (int l = 0; l < LANE_COUNT; ++l) {
+        config.lanes[l] = 1;
+    }
+    config.tensor = 1;
+
+    Replay replay;
+    replay.spec.width  = MIN_WIDTH + data[0] % (LARGE_CASE_SIZE - MIN_WIDTH + 1);
+    replay.spec.height = 1 + data[1] % LARGE_CASE_SIZE;
+    replay.spec.seed   = (uint64_t)data[2] | (uint64_t)data[3] << 8 |
+                         (uint64_t)data[4] << 16 | (uint64_t)data[5] << 24;
+    replay.count       = size - 6;
+    replay.inputs      = (char *)malloc(replay.count + 1);
+    if (!replay.inputs) {
+        return 0;
+    }
+    for (size_t i = 0; i < replay.count; ++i) {
+        replay.inputs[i] = KEYS[data[6 + i] & 7u];
+    }
+    config.deep_every = deep_interval(&replay.spec, 1);
+
+    Divergence div;
+    run_case(&replay.spec, &config, &scratch, replay.inputs, replay.count, NULL, &div);
+    if (div.found) {
+        minimize(&replay, &config, &scratch, &div);
+        report_divergence(&replay, &div, NULL);
+        abort();
+    }
+
+    free(replay.inputs);
+    return 0;
+}
+
+#else /* !SNAKE_LIBFUZZER */
+
+typedef struct Harness {
+    RunConfig     config;
+    long          cases;
+    long          seconds;
+    int           threads;
+    uint64_t      base_seed;
+    int           max_width;
+    int           max_height;
+    long          max_ticks;
+    const char   *out_path;
+    const char   *replay_path;
+
+    uint64_t      batch_first;
+    Scratch      *scratch;
+    char        **buffers;
+    atomic_int    failed;
+    atomic_ullong ticks;
+    atomic_ullong cases_run;
+
+    /* First divergent case of a batch, by case index. */
+    atomic_flag   report_lock;
+    uint64_t      bad_case;
+    Replay        bad;
+    Divergence    bad_div;
+} Harness;
+
+static CaseSpec case_spec(const Harness *h, uint64_t index, InputSource *source)
+{
+    uint64_t state      = (h->base_seed + index) * 0x9E3779B97F4A7C15ULL | 1u;
+    int      max_width  = h->max_width;
+    int      max_height = h->max_height;
+    CaseSpec spec;
+
+    /* Some boards span several sparse chunks, so the sparse lane
+       crosses chunk boundaries. */
+    if (utils_xorshift(&state) % LARGE_CASE_EVERY == 0) {
+        max_width  = LARGE_CASE_SIZE;
+        max_height = LARGE_CASE_SIZE;
+    }
+
+    spec.width  = MIN_WIDTH + (int)(utils_xorshift(&state) % (uint64_t)(max_width - MIN_WIDTH + 1));
+    spec.height = 1 + (int)(utils_xorshift(&state) % (uint64_t)max_height);
+    spec.seed   = utils_xorshift(&state);
+
+    source->state    = utils_xorshift(&state) | 1u;
+    source->cautious = (int)(utils_xorshift(&state) % 4 != 0);
+    return spec;
+}
+
+static void run_task(void *context, size_t task, int worker)
+{
+    Harness *h      = (Harness *)context;
+    char    *inputs = h->buffers[worker];
+
+    for (size_t k = 0; k < CASES_PER_TASK; ++k) {
+        if (atomic_load(&h->failed)) {
+            return;
+        }
+
+        uint64_t    index = h->batch_first + task * CASES_PER_TASK + k;
+        InputSource source;
+        CaseSpec    spec  = case_spec(h, index, &source);
+        Divergence  div;
+
+        if (h->cases > 0 && index >= (uint64_t)h->cases) {
+            return;
+        }
+
+        RunConfig config  = h->config;
+        config.deep_every = deep_interval(&spec, config.deep_every);
+
+        size_t ticks = run_case(&spec, &config, &h->scratch[worker], inputs,
+                                (size_t)h->max_ticks, &source, &div);
+        atomic_fetch_add(&h->ticks, ticks);
+        atomic_fetch_add(&h->cases_run, 1);
+
+        if (div.found) {
+            while (atomic_flag_test_and_set(&h->report_lock)) {
+            }
+            if (!atomic_load(&h->failed) || index < h->bad_case) {
+                char *copy = (char *)malloc(ticks + 1);
+                if (copy) {
+                    memcpy(copy, inputs, ticks);
+                    free(h->bad.inputs);
+                    h->bad.spec   = spec;
+                    h->bad.inputs = copy;
+                    h->bad.count  = ticks;
+                    h->bad_div    = div;
+                    h->bad_case   = index;
+                }
+                atomic_store(&h->failed, 1);
+            }
+            atomic_flag_clear(&h->report_lock);
+            return;
+        }
+    }
+}
+
+static int parse_lanes(char *list, RunConfig *config)
+{
+    for (int l = 0; l < LANE_COUNT; ++l) {
+        config->lanes[l] = 0;
+    }
+
+    for (char *name = strtok(list, ","); name; name = strtok(NULL, ",")) {
+        int l = 0;
+        while (l < LANE_COUNT && strcmp(LANES[l].name, name) != 0) {
+            ++l;
+        }
+        if (l == LANE_COUNT) {
+            fprintf(stderr, "[ERROR] Unknown lane '%s'.\n", name);
+            return 0;
+        }
+        config->lanes[l] = 1;
+    }
+    return 1;
+}
+
+static int parse_size(const char *text, Harness *h)
+{
+    int width  = 0;
+    int height = 0;
+
+    if (!utils_parse_size(text, &width, &height) || width < MIN_WIDTH) {
+        fprintf(stderr, "[ERROR] Bad board size '%s' (minimum width %d).\n", text, MIN_WIDTH);
+        return 0;
+    }
+    h->max_width  = width;
+    h->max_height = height;
+    return 1;
+}
+
+/* Returns 1 to run, 0 on a bad option and -1 for --help. */
+static int parse_arguments(int argc, char **argv, Harness *h)
+{
+    for (int i = 1; i < argc; ++i) {
+        const char *name  = argv[i];
+        char       *value = (i + 1 < argc) ? argv[i + 1] : NULL;
+        long        number;
+
+        if (strcmp(name, "--help") == 0 || strcmp(name, "-h") == 0) {
+            return -1;
+        }
+        if (!value) {
+            fprintf(stderr, "[ERROR] Option '%s' expects a value.\n", name);
+            return 0;
+        }
+
+        if (strcmp(name, "--cases") == 0 && utils_parse_long(value, 0, &number)) {
+            h->cases = number;
+        } else if (strcmp(name, "--seconds") == 0 && utils_parse_long(value, 0, &number)) {
+            h->seconds = number;
+        } else if (strcmp(name, "--threads") == 0 && utils_parse_long(value, 1, &number) &&
+                   number <= INT_MAX) {
+            h->threads = (int)number;
+        } else if (strcmp(name, "--seed") == 0 && utils_parse_long(value, 0, &number)) {
+            h->base_seed = (uint64_t)number;
+        } else if (strcmp(name, "--max-size") == 0) {
+            if (!parse_size(value, h)) {
+                return 0;
+            }
+        } else if (strcmp(name, "--max-ticks") == 0 && utils_parse_long(value, 1, &number)) {
+            h->max_ticks = number;
+        } else if (strcmp(name, "--deep-every") == 0 && utils_parse_long(value, 0, &number)) {
+            h->config.deep_every = number;
+        } else if (strcmp(name, "--lanes") == 0) {
+            if (!parse_lanes(value, &h->config)) {
+                return 0;
+            }
+        } else if (strcmp(name, "--tensor") == 0 &&
+                   (strcmp(value, "on") == 0 || strcmp(value, "off") == 0)) {
+            h->config.tensor = (strcmp(value, "on") == 0);
+        } else if (strcmp(name, "--out") == 0) {
+            h->out_path = value;
+        } else if (strcmp(name, "--replay") == 0) {
+            h->replay_path = value;
+        } else {
+            fprintf(stderr, "[ERROR] Bad option or value: %s %s\n", name, value);
+            return 0;
+        }
+        ++i;
+    }
+
+    if (h->cases == 0 && h->seconds == 0) {
+        fprintf(stderr, "[ERROR] --cases 0 needs --seconds.\n");
+        return 0;
+    }
+    return 1;
+}
+
+static int load_replay(const char *path, Replay *replay)
+{
+    FILE *in = fopen(path, "r");
+    if (!in) {
+        fprintf(stderr, "[ERROR] Cannot open '%s'.\n", path);
+        return 0;
+    }
+
+    unsigned long long seed = 0;
+    int                ok   = (fscanf(in, "%dx%d %llu ", &replay->spec.width,
+                                      &replay->spec.height, &seed) == 3);
+    replay->spec.seed = (uint64_t)seed;
+
+    long   begin = ftell(in);
+    fseek(in, 0, SEEK_END);
+    long   end   = ftell(in);
+    fseek(in, begin, SEEK_SET);
+
+    replay->inputs = (char *)malloc((size_t)(end - begin) + 1);
+    replay->count  = 0;
+    if (ok && replay->inputs) {
+        int c;
+        while ((c = fgetc(in)) != EOF && c != '\n' && c != '\r') {
+            if (c != '-') {
+                replay->inputs[replay->count++] = (char)c;
+            }
+        }
+    }
+    fclose(in);
+
+    if (!ok || !replay->inputs || replay->spec.width < MIN_WIDTH || replay->spec.height <= 0) {
+        fprintf(stderr, "[ERROR] '%s' is not a replay file.\n", path);
+        free(replay->inputs);
+        return 0;
+    }
+    return 1;
+}
+
+static int run_replay(Harness *h)
+{
+    Replay     replay;
+    Scratch    scratch;
+    Divergence div;
+
+    memset(&scratch, 0, sizeof(scratch));
+    if (!load_replay(h->replay_path, &replay)) {
+        return EXIT_FAILURE;
+    }
+
+    size_t ticks = run_case(&replay.spec, &h->config, &scratch, replay.inputs, replay.count,
+                            NULL, &div);
+    if (div.found) {
+        fprintf(stderr, "[ERROR] Divergence in lane '%s' after tick %llu: %s\n",
+                div.lane >= 0 ? LANES[div.lane].name : "?", div.tick, div.what);
+    } else {
+        printf("Replay of %zu inputs ran %zu ticks with no divergence.\n", replay.count, ticks);
+    }
+
+    scratch_free(&scratch);
+    free(replay.inputs);
+    return div.found ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+int main(int argc, char **argv)
+{
+    Harness h;
+    memset(&h, 0, sizeof(h));
+
+    for (int l = 0; l < LANE_COUNT; ++l) {
+        h.config.lanes[l] = 1;
+    }
+    h.config.tensor     = 1;
+    h.config.deep_every = DEFAULT_DEEP_EVERY;
+    h.cases             = DEFAULT_CASES;
+    h.max_width         = DEFAULT_MAX_WIDTH;
+    h.max_height        = DEFAULT_MAX_HEIGHT;
+    h.max_ticks         = DEFAULT_MAX_TICKS;
+    h.out_path          = DEFAULT_OUT;
+    h.base_seed         = 1;
+
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    h.threads = (cpus > 0) ? (int)cpus : 1;
+
+    int parsed = parse_arguments(argc, argv, &h);
+    if (parsed <= 0) {
+        fprintf(parsed < 0 ? stdout : stderr,
+                "Usage: %s [--cases N] [--seconds N] [--threads N] [--seed N] "
+                "[--max-size WxH] [--max-ticks N] [--deep-every N] "
+                "[--lanes dense,sparse,reach] [--tensor on|off] [--out PATH]\n"
+                "       %s --replay PATH\n", argv[0], argv[0]);
+        return parsed < 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    if (h.replay_path) {
+        return run_replay(&h);
+    }
+
+    WorkPool *pool = pool_create(h.threads);
+    h.scratch      = (Scratch *)calloc((size_t)h.threads, sizeof(Scratch));
+    h.buffers      = (char **)calloc((size_t)h.threads, sizeof(char *));
+    int ok         = pool && h.scratch && h.buffers;
+
+    for (int w = 0; ok && w < h.threads; ++w) {
+        h.buffers[w] = (char *)malloc((size_t)h.max_ticks + 1);
+        ok           = h.buffers[w] && scratch_reserve(&h.scratch[w], h.max_width, h.max_height);
+    }
+    if (!ok) {
+        fprintf(stderr, "[ERROR] Failed to set up the harness.\n");
+        return EXIT_FAILURE;
+    }
+
+    atomic_init(&h.failed, 0);
+    atomic_init(&h.ticks, 0);
+    atomic_init(&h.cases_run, 0);
+    atomic_flag_clear(&h.report_lock);
+
+    printf("Differential test on %d threads, boards up to %dx%d, lanes:", h.threads,
+           h.max_width, h.max_height);
+    for (int l = 0; l < LANE_COUNT; ++l) {
+        if (h.config.lanes[l]) {
+            printf(" %s", LANES[l].name);
+        }
+    }
+    printf("%s\n", h.config.tensor ? " (+tensor)" : "");
+    fflush(stdout);
+
+    const size_t batch_tasks = (size_t)h.threads * 16;
+    const size_t batch_cases = batch_tasks * CASES_PER_TASK;
+    long long    start       = utils_now_ns();
+    long long    last_report = start;
+
+    for (;;) {
+        if (h.cases > 0 && h.batch_first >= (uint64_t)h.cases) {
+            break;
+        }
+        if (h.seconds > 0 && utils_now_ns() - start >= h.seconds * 1000000000LL) {
+            break;
+        }
+
+        pool_run(pool, batch_tasks, POOL_STEAL, run_task, &h);
+        h.batch_first += batch_cases;
+        if (atomic_load(&h.failed)) {
+            break;
+        }
+
+        long long now = utils_now_ns();
+        if (now - last_report >= 10 * 1000000000LL) {
+            last_report = now;
+            printf("  %llu cases, %llu ticks, %.1f M ticks/s\n",
+                   (unsigned long long)atomic_load(&h.cases_run),
+                   (unsigned long long)atomic_load(&h.ticks),
+                   (double)atomic_load(&h.ticks) / ((double)(now - start) / 1e9) / 1e6);
+            fflush(stdout);
+        }
+    }
+
+    long long          elapsed = utils_now_ns() - start;
+    unsigned long long ticks   = atomic_load(&h.ticks);
+    int                status  = EXIT_SUCCESS;
+
+    printf("%llu cases, %llu ticks in %.2f s (%.1f M lockstep ticks/s)\n",
+           (unsigned long long)atomic_load(&h.cases_run), ticks, (double)elapsed / 1e9,
+           (double)ticks / ((double)elapsed / 1e9) / 1e6);
+
+    if (atomic_load(&h.failed)) {
+        fprintf(stderr, "[ERROR] Case %llu diverged; minimizing...\n",
+                (unsigned long long)h.bad_case);
+        minimize(&h.bad, &h.config, &h.scratch[0], &h.bad_div);
+        report_divergence(&h.bad, &h.bad_div, h.out_path);
+        status = EXIT_FAILURE;
+    } else {
+        printf("No divergence.\n");
+    }
+
+    for (int w = 0; w < h.threads; ++w) {
+        scratch_free(&h.scratch[w]);
+        free(h.buffers[w]);
+    }
+    free(h.scratch);
+    free(h.buffers);
+    free(h.bad.inputs);
+    pool_destroy(pool);
+    return status;
+}
+
+#endif /* SNAKE_LIBFUZZER */
@@ -0,0 +1,316 @@
+/*
+===========================================================
+ Project:    Snake Game in Console
+ File:       mapgen.c
+ Author:     Mobin Yousefi (GitHub: github.com/mobinyousefi-cs)
+ Created:    2026-10-19
+ Updated:    2026-10-19
+ License:    MIT License (see LICENSE file for details)
+===========================================================
+
+ Description:
+    Authoring tool for level maps. Converts a text drawing
+    into the binary map format, or generates a random map of
+    any size, then loads the result once so the distance
+    field cache is built next to it.
+
+ Usage:
+    make -f Makefile.mak tools
+    ./mapgen --text levels/cross.txt --out cross.snkmap
+    ./mapgen --random 400x200 --out big.snkmap
+             [--density PERCENT] [--exits N] [--food-goal N]
+             [--seed N]
+
+ Notes:
+    - Text maps: '#' obstacle, 'E' exit, 'S' snake head (the
+      body trails to the left), anything else is free. The
+      widest line sets the width.
+    - Random maps scatter straight wall segments and border
+      exits, keeping the start row clear.
+===========================================================
+*/
+
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "config.h"
+#include "level.h"
+#include "utils.h"
+
+#define MAX_LINE          65536
+#define SEGMENT_MAX       12
+#define DEFAULT_DENSITY   8
+#define DEFAULT_EXITS     2
+#define DEFAULT_GOAL      5
+#define MAX_DENSITY       60
+
+typedef struct MapOptions {
+    const char *text_path;
+    const char *out_path;
+    int         random;
+    int         width;
+    int         height;
+    int         density;
+    int         exits;
+    long        goal;
+    uint64_t    seed;
+} MapOptions;
+
+typedef struct Planes {
+    int       width;
+    int       height;
+    size_t    words;
+    uint64_t *obstacles;
+    uint64_t *exits;
+} Planes;
+
+static int planes_init(Planes *planes, int width, int height)
+{
+    planes->width     = width;
+    planes->height    = height;
+    planes->words     = level_words_per_row(width);
+    planes->obstacles = (uint64_t *)calloc(planes->words * (size_t)height, sizeof(uint64_t));
+    planes->exits     = (uint64_t *)calloc(planes->words * (size_t)height, sizeof(uint64_t));
+    return planes->obstacles && planes->exits;
+}
+
+static void planes_free(Planes *planes)
+{
+    free(planes->obstacles);
+    free(planes->exits);
+}
+
+static void set_bit(const Planes *planes, uint64_t *plane, int x, int y, int value)
+{
+    uint64_t *word = &plane[(size_t)y * planes->words + ((unsigned)x >> 6)];
+    uint64_t  bit  = (uint64_t)1 << (x & 63);
+    *word = value ? (*word | bit) : (*word & ~bit);
+}
+
+static int from_text(const char *path, Planes *planes, Position *start)
+{
+    FILE *in = fopen(path, "r");
+    if (!in) {
+        fprintf(stderr, "[ERROR] Cannot open '%s'.\n", path);
+        return 0;
+    }
+
+    static char line[MAX_LINE];
+    int         width  = 0;
+    int         height = 0;
+
+    while (fgets(line, sizeof(line), in)) {
+        int length = (int)strcspn(line, "\r\n");
+        if (length > width) {
+            width = length;
+        }
+        height++;
+    }
+
+    if (width == 0 || !planes_init(planes, width, height)) {
+        fprintf(stderr, "[ERROR] '%s' is empty or too large.\n", path);
+        fclose(in);
+        return 0;
+    }
+
+    start->x = -1;
+    start->y = -1;
+    rewind(in);
+
+    for (int y = 0; y < height && fgets(line, sizeof(line), in); ++y) {
+        int length = (int)strcspn(line, "\r\n");
+        for (int x = 0; x < length; ++x) {
+            switch (line[x]) {
+            case '#':
+                set_bit(planes, planes->obstacles, x, y, 1);
+                break;
+            case 'E':
+                set_bit(planes, planes->exits, x, y, 1);
+                break;
+            case 'S':
+                start->x = x;
+                start->y = y;
+                break;
+            default:
+                break;
+            }
+        }
+    }
+
+    fclose(in);
+
+    if (start->x < 0) {
+        start->x = width / 2;
+        start->y = height / 2;
+    }
+    return 1;
+}
+
+static int random_map(int width, int height, int density, int exits, uint64_t seed,
+                      Planes *planes, Position *start)
+{
+    if (!planes_init(planes, width, height)) {
+        fprintf(stderr, "[ERROR] Out of memory for a %dx%d map.\n", width, height);
+        return 0;
+    }
+
+    uint64_t  state  = (seed * 0x9E3779B97F4A7C15ULL) | 1u;
+    long long target = (long long)width * height * density / 100;
+
+    start->x = width / 2;
+    start->y = height / 2;
+
+    for (long long placed = 0; placed < target;) {
+        int x          = (int)(utils_xorshift(&state) % (uint64_t)width);
+        int y          = (int)(utils_xorshift(&state) % (uint64_t)height);
+        int horizontal = (int)(utils_xorshift(&state) & 1u);
+        int length     = 2 + (int)(utils_xorshift(&state) % SEGMENT_MAX);
+
+        for (int i = 0; i < length; ++i, ++placed) {
+            int cx = horizontal ? x + i : x;
+            int cy = horizontal ? y : y + i;
+            if (cx >= width || cy >= height) {
+                break;
+            }
+            /* Keep the start row clear for the spawn and first moves. */
+            if (cy != start->y) {
+                set_bit(planes, planes->obstacles, cx, cy, 1);
+            }
+        }
+    }
+
+    for (int i = 0; i < exits; ++i) {
+        int side = (int)(utils_xorshift(&state) % 4u);
+        int x    = (int)(utils_xorshift(&state) % (uint64_t)width);
+        int y    = (int)(utils_xorshift(&state) % (uint64_t)height);
+
+        if (side == 0) {
+            y = 0;
+        } else if (side == 1) {
+            y = height - 1;
+        } else if (side == 2) {
+            x = 0;
+        } else {
+            x = width - 1;
+        }
+        set_bit(planes, planes->obstacles, x, y, 0);
+        set_bit(planes, planes->exits, x, y, 1);
+    }
+
+    return 1;
+}
+
+/* Returns 1 to run, 0 on a bad option and -1 for --help. */
+static int parse_arguments(int argc, char **argv, MapOptions *options)
+{
+    for (int i = 1; i < argc; ++i) {
+        const char *name  = argv[i];
+        const char *value = (i + 1 < argc) ? argv[i + 1] : NULL;
+        long        number;
+
+        if (strcmp(name, "--help") == 0 || strcmp(name, "-h") == 0) {
+            return -1;
+        }
+        if (!value) {
+            fprintf(stderr, "[ERROR] Option '%s' expects a value.\n", name);
+            return 0;
+        }
+
+        if (strcmp(name, "--text") == 0) {
+            options->text_path = value;
+        } else if (strcmp(name, "--out") == 0) {
+            options->out_path = value;
+        } else if (strcmp(name, "--random") == 0 &&
+                   utils_parse_size(value, &options->width, &options->height)) {
+            options->random = 1;
+        } else if (strcmp(name, "--density") == 0 && utils_parse_long(value, 0, &number) &&
+                   number <= MAX_DENSITY) {
+            options->density = (int)number;
+        } else if (strcmp(name, "--exits") == 0 && utils_parse_long(value, 0, &number) &&
+                   number <= INT_MAX) {
+            options->exits = (int)number;
+        } else if (strcmp(name, "--food-goal") == 0 && utils_parse_long(value, 0, &number)) {
+            options->goal = number;
+        } else if (strcmp(name, "--seed") == 0 && utils_parse_long(value, 0, &number)) {
+            options->seed = (uint64_t)number;
+        } else {
+            fprintf(stderr, "[ERROR] Bad option or value: %s %s\n", name, value);
+            return 0;
+        }
+        ++i;
+    }
+
+    if (!options->out_path || options->random == (options->text_path != NULL)) {
+        fprintf(stderr, "[ERROR] Give --out and exactly one of --text or --random.\n");
+        return 0;
+    }
+    return 1;
+}
+
+int main(int argc, char **argv)
+{
+    MapOptions options;
+    memset(&options, 0, sizeof(options));
+    options.density = DEFAULT_DENSITY;
+    options.exits   = DEFAULT_EXITS;
+    options.goal    = DEFAULT_GOAL;
+    options.seed    = 1;
+
+    int parsed = parse_arguments(argc, argv, &options);
+    if (parsed <= 0) {
+        fprintf(parsed < 0 ? stdout : stderr,
+                "Usage: %s (--text FILE | --random WxH) --out PATH [--density PERCENT] "
+                "[--exits N] [--food-goal N] [--seed N]\n", argv[0]);
+        return parsed < 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    Planes   planes;
+    Position start;
+    memset(&planes, 0, sizeof(planes));
+
+    int ok = options.text_path ? from_text(options.text_path, &planes, &start)
+                               : random_map(options.width, options.height, options.density,
+                                            options.exits, options.seed, &planes, &start);
+    if (!ok) {
+        planes_free(&planes);
+        return EXIT_FAILURE;
+    }
+
+    /* The spawn cells must be free whatever the drawing says. */
+    for (int i = 0; i < SNAKE_INITIAL_LENGTH && start.x - i >= 0; ++i) {
+        set_bit(&planes, planes.obstacles, start.x - i, start.y, 0);
+        set_bit(&planes, planes.exits, start.x - i, start.y, 0);
+    }
+
+    LevelDesc desc;
+    desc.width     = planes.width;
+    desc.height    = planes.height;
+    desc.start     = start;
+    desc.food_goal = (unsigned long)options.goal;
+    desc.obstacles = planes.obstacles;
+    desc.exits     = planes.exits;
+
+    ok = level_save(options.out_path, &desc);
+    planes_free(&planes);
+    if (!ok) {
+        fprintf(stderr, "[ERROR] Failed to write '%s'.\n", options.out_path);
+        return EXIT_FAILURE;
+    }
+
+    long long begin = utils_now_ns();
+    Level    *level = level_load(options.out_path);
+    long long end   = utils_now_ns();
+    if (!level) {
+        return EXIT_FAILURE;
+    }
+
+    printf("%s: %dx%d, %lu exits, food goal %lu, fields %s (%.1f ms)\n",
+           options.out_path, level->width, level->height, level->exit_count, level->food_goal,
+           level->wall_distance ? "cached" : "skipped (map too large)",
+           (double)(end - begin) / 1e6);
+
+    level_destroy(level);
+    return EXIT_SUCCESS;
+}
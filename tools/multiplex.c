@@ -0,0 +1,251 @@
+/*
+===========================================================
+ Project:    Snake Game in Console
+ File:       multiplex.c
+ Author:     Mobin Yousefi (GitHub: github.com/mobinyousefi-cs)
+ Created:    2026-10-19
+ Updated:    2026-10-19
+ License:    MIT License (see LICENSE file for details)
+===========================================================
+
+ Description:
+    Example host loop that multiplexes many headless game
+    sessions on a single thread. Sessions sit in a min-heap
+    keyed on the deadline returned by session_pump(); the
+    loop sleeps until the earliest one, exactly as an epoll
+    or io_uring loop would with a timer. Finished games are
+    replaced so the population stays constant.
+
+ Usage:
+    make -f Makefile.mak tools
+    ./multiplex [--sessions N] [--tick-ms N] [--seconds N]
+                [--policy NAME]
+===========================================================
+*/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "config.h"
+#include "game.h"
+#include "policy.h"
+#include "session.h"
+#include "utils.h"
+
+typedef struct Slot {
+    GameSession session;
+    Policy     *bot;
+    long long   deadline_ns;
+} Slot;
+
+typedef struct Host {
+    Slot       *slots;
+    int        *heap;
+    int         count;
+    uint64_t    next_seed;
+    PolicyKind  policy;
+    long long   tick_ns;
+} Host;
+
+static int heap_less(const Host *host, int a, int b)
+{
+    return host->slots[host->heap[a]].deadline_ns < host->slots[host->heap[b]].deadline_ns;
+}
+
+static void heap_swap(Host *host, int a, int b)
+{
+    int tmp       = host->heap[a];
+    host->heap[a] = host->heap[b];
+    host->heap[b] = tmp;
+}
+
+static void heap_sift_down(Host *host, int i)
+{
+    for (;;) {
+        int smallest = i;
+        int left     = 2 * i + 1;
+        int right    = left + 1;
+
+        if (left < host->count && heap_less(host, left, smallest)) {
+            smallest = left;
+        }
+        if (right < host->count && heap_less(host, right, smallest)) {
+            smallest = right;
+        }
+        if (smallest == i) {
+            return;
+        }
+        heap_swap(host, i, smallest);
+        i = smallest;
+    }
+}
+
+static int start_game(Host *host, Slot *slot, long long now_ns)
+{
+    Game *game = game_create_ex(BOARD_WIDTH, BOARD_HEIGHT, host->next_seed);
+    slot->bot  = policy_create(host->policy, host->next_seed);
+    host->next_seed++;
+
+    if (!game || !slot->bot) {
+        game_destroy(game);
+        policy_destroy(slot->bot);
+        slot->bot = NULL;
+        return 0;
+    }
+
+    session_init(&slot->session, game, NULL, host->tick_ns, now_ns);
+    slot->deadline_ns = now_ns;
+    return 1;
+}
+
+static void end_game(Slot *slot)
+{
+    game_destroy(slot->session.game);
+    policy_destroy(slot->bot);
+    slot->session.game = NULL;
+    slot->bot          = NULL;
+}
+
+/* Returns 1 to run, 0 on a bad option and -1 for --help. */
+static int parse_arguments(int argc, char **argv, long *sessions, long *tick_ms,
+                           long *seconds, PolicyKind *policy)
+{
+    for (int i = 1; i < argc; ++i) {
+        const char *name  = argv[i];
+        const char *value = (i + 1 < argc) ? argv[i + 1] : NULL;
+        long        number;
+
+        if (strcmp(name, "--help") == 0 || strcmp(name, "-h") == 0) {
+            return -1;
+        }
+        if (!value) {
+            fprintf(stderr, "[ERROR] Option '%s' expects a value.\n", name);
+            return 0;
+        }
+
+        if (strcmp(name, "--sessions") == 0 && utils_parse_long(value, 1, &number) &&
+            number <= INT_MAX) {
+            *sessions = number;
+        } else if (strcmp(name, "--tick-ms") == 0 && utils_parse_long(value, 1, &number)) {
+            *tick_ms = number;
+        } else if (strcmp(name, "--seconds") == 0 && utils_parse_long(value, 1, &number)) {
+            *seconds = number;
+        } else if (strcmp(name, "--policy") != 0 || !policy_from_name(value, policy)) {
+            fprintf(stderr, "[ERROR] Bad option or value: %s %s\n", name, value);
+            return 0;
+        }
+        ++i;
+    }
+
+    return 1;
+}
+
+int main(int argc, char **argv)
+{
+    long sessions = 1000;
+    long tick_ms  = GAME_TICK_MS;
+    long seconds  = 5;
+    Host host;
+
+    memset(&host, 0, sizeof(host));
+    host.policy    = POLICY_GREEDY;
+    host.next_seed = 1;
+
+    int parsed = parse_arguments(argc, argv, &sessions, &tick_ms, &seconds, &host.policy);
+    if (parsed <= 0) {
+        fprintf(parsed < 0 ? stdout : stderr,
+                "Usage: %s [--sessions N] [--tick-ms N] [--seconds N] [--policy NAME]\n", argv[0]);
+        return parsed < 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    host.tick_ns = tick_ms * 1000000LL;
+    host.slots   = (Slot *)calloc((size_t)sessions, sizeof(Slot));
+    host.heap    = (int *)malloc((size_t)sessions * sizeof(int));
+    if (!host.slots || !host.heap) {
+        fprintf(stderr, "[ERROR] Out of memory.\n");
+        return EXIT_FAILURE;
+    }
+
+    long long start = utils_now_ns();
+
+    /* Stagger the first ticks so sessions do not all fire at once. */
+    for (int i = 0; i < sessions; ++i) {
+        long long offset = host.tick_ns * i / sessions;
+        if (!start_game(&host, &host.slots[i], start + offset)) {
+            fprintf(stderr, "[ERROR] Failed to create game.\n");
+            return EXIT_FAILURE;
+        }
+        host.heap[host.count++] = i;
+    }
+
+    const long long    stop     = start + seconds * 1000000000LL;
+    unsigned long long pumps    = 0;
+    unsigned long long games    = 0;
+    long long          late_sum = 0;
+    long long          late_max = 0;
+    long long          busy_ns  = 0;
+
+    for (;;) {
+        Slot     *slot = &host.slots[host.heap[0]];
+        long long now  = utils_now_ns();
+
+        if (now >= stop) {
+            break;
+        }
+
+        if (slot->deadline_ns > now) {
+            if (slot->deadline_ns >= stop) {
+                break;
+            }
+            utils_sleep_ms((int)((slot->deadline_ns - now + 999999LL) / 1000000LL));
+            continue;
+        }
+
+        long long late = now - slot->deadline_ns;
+        late_sum += late;
+        if (late > late_max) {
+            late_max = late;
+        }
+
+        GameSession *session = &slot->session;
+        session_push_input(session, session_turn_input(policy_choose(slot->bot, session->game)));
+
+        long long deadline = session_pump(session, now);
+        pumps++;
+
+        if (deadline == SESSION_DONE) {
+            games++;
+            end_game(slot);
+            if (!start_game(&host, slot, now + host.tick_ns)) {
+                fprintf(stderr, "[ERROR] Failed to create game.\n");
+                return EXIT_FAILURE;
+            }
+        } else {
+            slot->deadline_ns = deadline;
+        }
+
+        heap_sift_down(&host, 0);
+        busy_ns += utils_now_ns() - now;
+    }
+
+    long long elapsed = utils_now_ns() - start;
+
+    printf("sessions        %ld on one thread, %ld ms ticks, %s bots\n",
+           sessions, tick_ms, policy_name(host.policy));
+    printf("pumps           %llu (%.0f/s)\n", pumps, (double)pumps * 1e9 / (double)elapsed);
+    printf("games finished  %llu\n", games);
+    printf("wake lateness   mean %.1f us, max %.1f us\n",
+           pumps ? (double)late_sum / (double)pumps / 1000.0 : 0.0, (double)late_max / 1000.0);
+    printf("thread busy     %.1f%%\n", 100.0 * (double)busy_ns / (double)elapsed);
+
+    for (int i = 0; i < sessions; ++i) {
+        end_game(&host.slots[i]);
+    }
+    free(host.heap);
+    free(host.slots);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,448 @@
+/*
+===========================================================
+ Project:    Snake Game in Console
+ File:       tournament.c
+ Author:     Mobin Yousefi (GitHub: github.com/mobinyousefi-cs)
+ Created:    2026-10-19
+ Updated:    2026-10-19
+ License:    MIT License (see LICENSE file for details)
+===========================================================
+
+ Description:
+    Self-play tournament runner. Every policy plays every
+    board size and seed; policies are then compared round
+    robin on identical (size, seed) pairs. Games run on the
+    work-stealing pool, and the tool reports a results table
+    plus engine throughput, so it doubles as the regression
+    benchmark for engine speed and policy strength.
+
+ Usage:
+    make -f Makefile.mak tournament
+    ./tournament [--policies random,greedy,autopilot,search]
+                 [--sizes 20x10,40x20,100x50] [--seeds N]
+                 [--threads N] [--max-ticks N] [--seed N]
+                 [--schedule steal|static] [--map PATH]
+                 [--reach on|off] [--stop-trapped on|off]
+
+    With --map every game is played on the given level and
+    --sizes is ignored; games that reach an open exit are
+    counted in the "exit" column.
+
+    Games track reachable area incrementally (--reach on,
+    the default), which the searching bots query instead of
+    flood filling. --stop-trapped ends a game as soon as no
+    move leaves room for the snake's length, counting it in
+    the "trap" column.
+===========================================================
+*/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "game.h"
+#include "level.h"
+#include "policy.h"
+#include "pool.h"
+#include "utils.h"
+
+#define MAX_SIZES           16
+#define DEFAULT_SEEDS       32
+#define DEFAULT_MAX_TICKS   200000L
+
+typedef enum Outcome {
+    OUTCOME_WALL = 0,
+    OUTCOME_SELF,
+    OUTCOME_TIMEOUT,
+    OUTCOME_EXIT,
+    OUTCOME_TRAPPED,
+    OUTCOME_COUNT
+} Outcome;
+
+typedef struct BoardSize {
+    int width;
+    int height;
+} BoardSize;
+
+typedef struct MatchResult {
+    int                score;
+    unsigned long long ticks;
+    Outcome            outcome;
+    int                failed;
+} MatchResult;
+
+typedef struct Tournament {
+    PolicyKind   policies[POLICY_COUNT];
+    int          policy_count;
+    BoardSize    sizes[MAX_SIZES];
+    int          size_count;
+    int          seeds;
+    long         max_ticks;
+    uint64_t     base_seed;
+    int          threads;
+    PoolSchedule schedule;
+    const char  *map_path;
+    Level       *level;
+    int          reach;
+    int          stop_trapped;
+    MatchResult *results;
+} Tournament;
+
+typedef struct Standing {
+    int                wins;
+    int                draws;
+    int                losses;
+    long long          score_sum;
+    unsigned long long tick_sum;
+    int                outcomes[OUTCOME_COUNT];
+} Standing;
+
+static size_t task_count(const Tournament *t)
+{
+    return (size_t)t->policy_count * (size_t)t->size_count * (size_t)t->seeds;
+}
+
+/* Tasks are laid out [policy][size][seed]. */
+static size_t task_index(const Tournament *t, int policy, int size, int seed)
+{
+    return ((size_t)policy * (size_t)t->size_count + (size_t)size) * (size_t)t->seeds + (size_t)seed;
+}
+
+static void play_match(void *context, size_t task, int worker)
+{
+    Tournament  *t      = (Tournament *)context;
+    MatchResult *result = &t->results[task];
+
+    (void)worker;
+
+    int seed   = (int)(task % (size_t)t->seeds);
+    int size   = (int)((task / (size_t)t->seeds) % (size_t)t->size_count);
+    int policy = (int)(task / ((size_t)t->seeds * (size_t)t->size_count));
+
+    const BoardSize  dims      = t->sizes[size];
+    const uint64_t   game_seed = t->base_seed + (uint64_t)seed;
+    const long       starve    = (long)dims.width * dims.height * 2 + 1000;
+
+    Game   *game = t->level ? game_create_level(t->level, game_seed)
+                         : game_create_ex(dims.width, dims.height, game_seed);
+    Policy *bot  = policy_create(t->policies[policy], game_seed ^ (uint64_t)(policy + 1));
+
+    if (!game || !bot || (t->reach && game->board->cells && !game_enable_reach(game))) {
+        result->failed = 1;
+        policy_destroy(bot);
+        game_destroy(game);
+        return;
+    }
+
+    long since_food = 0;
+    int  last_score = 0;
+    int  trapped    = 0;
+
+    while (game->status == GAME_RUNNING &&
+           (long)game->stats.ticks < t->max_ticks && since_food < starve) {
+        if (t->stop_trapped && !game_has_safe_move(game)) {
+            trapped = 1;
+            break;
+        }
+        game_change_direction(game, policy_choose(bot, game));
+        game_update(game);
+
+        if (game->score != last_score) {
+            last_score = game->score;
+            since_food = 0;
+        } else {
+            since_food++;
+        }
+    }
+
+    result->score = game->score;
+    result->ticks = game->stats.ticks;
+    if (trapped) {
+        result->outcome = OUTCOME_TRAPPED;
+    } else if (game->status == GAME_RUNNING) {
+        result->outcome = OUTCOME_TIMEOUT;
+    } else if (game->status == GAME_OVER_EXIT) {
+        result->outcome = OUTCOME_EXIT;
+    } else {
+        result->outcome = (game->stats.death == DEATH_WALL) ? OUTCOME_WALL : OUTCOME_SELF;
+    }
+
+    policy_destroy(bot);
+    game_destroy(game);
+}
+
+static int parse_policies(char *list, Tournament *t)
+{
+    t->policy_count = 0;
+
+    for (char *name = strtok(list, ","); name; name = strtok(NULL, ",")) {
+        if (t->policy_count >= POLICY_COUNT ||
+            !policy_from_name(name, &t->policies[t->policy_count])) {
+            fprintf(stderr, "[ERROR] Unknown or repeated policy '%s'.\n", name);
+            return 0;
+        }
+        t->policy_count++;
+    }
+
+    return t->policy_count > 0;
+}
+
+static int parse_sizes(char *list, Tournament *t)
+{
+    t->size_count = 0;
+
+    for (char *item = strtok(list, ","); item; item = strtok(NULL, ",")) {
+        int w = 0;
+        int h = 0;
+        if (t->size_count >= MAX_SIZES || !utils_parse_size(item, &w, &h)) {
+            fprintf(stderr, "[ERROR] Bad board size '%s' (expected WxH).\n", item);
+            return 0;
+        }
+        t->sizes[t->size_count].width  = w;
+        t->sizes[t->size_count].height = h;
+        t->size_count++;
+    }
+
+    return t->size_count > 0;
+}
+
+/* Returns 1 to run, 0 on a bad option and -1 for --help. */
+static int parse_arguments(int argc, char **argv, Tournament *t)
+{
+    for (int i = 1; i < argc; ++i) {
+        const char *name  = argv[i];
+        char       *value = (i + 1 < argc) ? argv[i + 1] : NULL;
+        long        number;
+
+        if (strcmp(name, "--help") == 0 || strcmp(name, "-h") == 0) {
+            return -1;
+        }
+        if (!value) {
+            fprintf(stderr, "[ERROR] Option '%s' expects a value.\n", name);
+            return 0;
+        }
+
+        if (strcmp(name, "--policies") == 0) {
+            if (!parse_policies(value, t)) {
+                return 0;
+            }
+        } else if (strcmp(name, "--sizes") == 0) {
+            if (!parse_sizes(value, t)) {
+                return 0;
+            }
+        } else if (strcmp(name, "--seeds") == 0 && utils_parse_long(value, 1, &number) &&
+                   number <= INT_MAX) {
+            t->seeds = (int)number;
+        } else if (strcmp(name, "--threads") == 0 && utils_parse_long(value, 1, &number) &&
+                   number <= INT_MAX) {
+            t->threads = (int)number;
+        } else if (strcmp(name, "--max-ticks") == 0 && utils_parse_long(value, 1, &number)) {
+            t->max_ticks = number;
+        } else if (strcmp(name, "--seed") == 0 && utils_parse_long(value, 0, &number)) {
+            t->base_seed = (uint64_t)number;
+        } else if (strcmp(name, "--schedule") == 0 &&
+                   (strcmp(value, "steal") == 0 || strcmp(value, "static") == 0)) {
+            t->schedule = (strcmp(value, "steal") == 0) ? POOL_STEAL : POOL_STATIC;
+        } else if (strcmp(name, "--map") == 0) {
+            t->map_path = value;
+        } else if (strcmp(name, "--reach") == 0 &&
+                   (strcmp(value, "on") == 0 || strcmp(value, "off") == 0)) {
+            t->reach = (strcmp(value, "on") == 0);
+        } else if (strcmp(name, "--stop-trapped") == 0 &&
+                   (strcmp(value, "on") == 0 || strcmp(value, "off") == 0)) {
+            t->stop_trapped = (strcmp(value, "on") == 0);
+        } else {
+            fprintf(stderr, "[ERROR] Bad option or value: %s %s\n", name, value);
+            return 0;
+        }
+        ++i;
+    }
+
+    return 1;
+}
+
+static void score_round_robin(const Tournament *t, Standing *standings)
+{
+    memset(standings, 0, sizeof(Standing) * (size_t)t->policy_count);
+
+    for (int p = 0; p < t->policy_count; ++p) {
+        for (int s = 0; s < t->size_count; ++s) {
+            for (int k = 0; k < t->seeds; ++k) {
+                const MatchResult *r = &t->results[task_index(t, p, s, k)];
+                standings[p].score_sum += r->score;
+                standings[p].tick_sum  += r->ticks;
+                standings[p].outcomes[r->outcome]++;
+            }
+        }
+    }
+
+    for (int a = 0; a < t->policy_count; ++a) {
+        for (int b = a + 1; b < t->policy_count; ++b) {
+            for (int s = 0; s < t->size_count; ++s) {
+                for (int k = 0; k < t->seeds; ++k) {
+                    int sa = t->results[task_index(t, a, s, k)].score;
+                    int sb = t->results[task_index(t, b, s, k)].score;
+
+                    if (sa > sb) {
+                        standings[a].wins++;
+                        standings[b].losses++;
+                    } else if (sa < sb) {
+                        standings[b].wins++;
+                        standings[a].losses++;
+                    } else {
+                        standings[a].draws++;
+                        standings[b].draws++;
+                    }
+                }
+            }
+        }
+    }
+}
+
+static void print_report(const Tournament *t, const WorkPool *pool, long long elapsed_ns)
+{
+    Standing standings[POLICY_COUNT];
+    score_round_robin(t, standings);
+
+    const int games_per_policy = t->size_count * t->seeds;
+
+    printf("\nRound robin (%d sizes x %d seeds, win = higher score on the same board and seed)\n\n",
+           t->size_count, t->seeds);
+    printf("%-10s %6s %6s %6s %7s %10s %11s %6s %6s %8s %6s %6s\n",
+           "policy", "wins", "draws", "losses", "points", "mean score", "mean ticks",
+           "wall", "self", "timeout", "exit", "trap");
+
+    for (int p = 0; p < t->policy_count; ++p) {
+        const Standing *st = &standings[p];
+        printf("%-10s %6d %6d %6d %7.1f %10.1f %11.1f %6d %6d %8d %6d %6d\n",
+               policy_name(t->policies[p]), st->wins, st->draws, st->losses,
+               st->wins + 0.5 * st->draws,
+               (double)st->score_sum / games_per_policy,
+               (double)st->tick_sum / games_per_policy,
+               st->outcomes[OUTCOME_WALL], st->outcomes[OUTCOME_SELF],
+               st->outcomes[OUTCOME_TIMEOUT], st->outcomes[OUTCOME_EXIT],
+               st->outcomes[OUTCOME_TRAPPED]);
+    }
+
+    printf("\nMean score by board size\n\n%-10s", "policy");
+    for (int s = 0; s < t->size_count; ++s) {
+        char label[32];
+        snprintf(label, sizeof(label), "%dx%d", t->sizes[s].width, t->sizes[s].height);
+        printf(" %11s", label);
+    }
+    putchar('\n');
+
+    for (int p = 0; p < t->policy_count; ++p) {
+        printf("%-10s", policy_name(t->policies[p]));
+        for (int s = 0; s < t->size_count; ++s) {
+            long long sum = 0;
+            for (int k = 0; k < t->seeds; ++k) {
+                sum += t->results[task_index(t, p, s, k)].score;
+            }
+            printf(" %11.1f", (double)sum / t->seeds);
+        }
+        putchar('\n');
+    }
+
+    unsigned long long total_ticks = 0;
+    for (size_t i = 0; i < task_count(t); ++i) {
+        total_ticks += t->results[i].ticks;
+    }
+
+    const double seconds = (double)elapsed_ns / 1e9;
+
+    printf("\nThroughput (%s scheduling, %d threads)\n\n",
+           (t->schedule == POOL_STEAL) ? "work-stealing" : "static", t->threads);
+    printf("games       %zu\n", task_count(t));
+    printf("ticks       %llu\n", total_ticks);
+    printf("wall time   %.3f s\n", seconds);
+    printf("games/s     %.1f\n", (double)task_count(t) / seconds);
+    printf("ticks/s     %.0f (%.1f ns/tick incl. policy)\n",
+           (double)total_ticks / seconds,
+           total_ticks ? (double)elapsed_ns * t->threads / (double)total_ticks : 0.0);
+
+    printf("\n%-8s %8s %8s %8s\n", "worker", "games", "steals", "busy");
+    for (int w = 0; w < pool_thread_count(pool); ++w) {
+        const PoolWorkerStats *ws = pool_worker_stats(pool, w);
+        printf("%-8d %8llu %8llu %7.1f%%\n", w, ws->tasks, ws->steals,
+               elapsed_ns ? 100.0 * (double)ws->busy_ns / (double)elapsed_ns : 0.0);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    static char default_policies[] = "random,greedy,autopilot,search";
+    static char default_sizes[]    = "20x10,40x20,100x50";
+
+    Tournament t;
+    memset(&t, 0, sizeof(t));
+    t.seeds     = DEFAULT_SEEDS;
+    t.max_ticks = DEFAULT_MAX_TICKS;
+    t.base_seed = 1;
+    t.schedule  = POOL_STEAL;
+    t.reach     = 1;
+
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    t.threads = (cpus > 0) ? (int)cpus : 1;
+
+    parse_policies(default_policies, &t);
+    parse_sizes(default_sizes, &t);
+
+    int parsed = parse_arguments(argc, argv, &t);
+    if (parsed <= 0) {
+        fprintf(parsed < 0 ? stdout : stderr,
+                "Usage: %s [--policies LIST] [--sizes WxH,...] [--seeds N] "
+                "[--threads N] [--max-ticks N] [--seed N] "
+                "[--schedule steal|static] [--map PATH] "
+                "[--reach on|off] [--stop-trapped on|off]\n", argv[0]);
+        return parsed < 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    if (t.map_path) {
+        t.level = level_load(t.map_path);
+        if (!t.level) {
+            return EXIT_FAILURE;
+        }
+        t.size_count      = 1;
+        t.sizes[0].width  = t.level->width;
+        t.sizes[0].height = t.level->height;
+    }
+
+    t.results = (MatchResult *)calloc(task_count(&t), sizeof(MatchResult));
+    WorkPool *pool = pool_create(t.threads);
+    if (!t.results || !pool) {
+        fprintf(stderr, "[ERROR] Failed to set up the tournament.\n");
+        free(t.results);
+        pool_destroy(pool);
+        level_destroy(t.level);
+        return EXIT_FAILURE;
+    }
+
+    printf("Playing %zu games on %d threads...\n", task_count(&t), t.threads);
+    fflush(stdout);
+
+    long long start = utils_now_ns();
+    int       ok    = pool_run(pool, task_count(&t), t.schedule, play_match, &t);
+    long long end   = utils_now_ns();
+
+    for (size_t i = 0; ok && i < task_count(&t); ++i) {
+        if (t.results[i].failed) {
+            ok = 0;
+        }
+    }
+
+    if (!ok) {
+        fprintf(stderr, "[ERROR] Some games could not be created.\n");
+    } else {
+        print_report(&t, pool, end - start);
+    }
+
+    pool_destroy(pool);
+    level_destroy(t.level);
+    free(t.results);
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
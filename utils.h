@@ -4,25 +4,42 @@
  File:       utils.h
  Author:     Mobin Yousefi (GitHub: github.com/mobinyousefi-cs)
  Created:    2025-11-26
- Updated:    2025-11-26
+ Updated:    2026-10-19
  License:    MIT License (see LICENSE file for details)
 ===========================================================
 
  Description:
     Cross-platform console utilities for clearing the screen,
-    sleeping, and handling non-blocking keyboard input.
+    sleeping, timing, non-blocking keyboard input, and
+    non-blocking frame output, plus the small numeric helpers
+    (random streams, strict argument parsing, window clamping)
+    shared by the engine and the tools.
 ===========================================================
 */
 
 #ifndef UTILS_H
 #define UTILS_H
 
-int  utils_terminal_init(void);
-void utils_terminal_restore(void);
+#include <stddef.h>
+#include <stdint.h>
 
-void utils_clear_screen(void);
-void utils_sleep_ms(int ms);
-int  utils_kbhit(void);
-int  utils_getch(void);
+int       utils_terminal_init(void);
+void      utils_terminal_restore(void);
+
+void      utils_clear_screen(void);
+void      utils_sleep_ms(int ms);
+long long utils_now_ns(void);
+int       utils_kbhit(void);
+int       utils_getch(void);
+
+int       utils_stdout_set_nonblocking(int enable);
+long      utils_write_stdout(const char *data, size_t length);
+int       utils_wait_stdout_writable(int timeout_ms);
+
+uint64_t  utils_splitmix64(uint64_t seed);
+uint64_t  utils_xorshift(uint64_t *state);
+int       utils_parse_long(const char *text, long min, long *out);
+int       utils_parse_size(const char *text, int *width, int *height);
+int       utils_clamp_origin(int center, int extent, int size);
 
 #endif /* UTILS_H */
@@ -0,0 +1,65 @@
+/*
+===========================================================
+ Project:    Snake Game in Console
+ File:       writer.h
+ Author:     Mobin Yousefi (GitHub: github.com/mobinyousefi-cs)
+ Created:    2026-10-19
+ Updated:    2026-10-19
+ License:    MIT License (see LICENSE file for details)
+===========================================================
+
+ Description:
+    Asynchronous frame writer. The game thread composes a
+    frame into its own buffer and hands it to a dedicated
+    writer thread, which performs the blocking write to
+    stdout, so slow terminals never stall the tick.
+
+ Notes:
+    - Three buffers rotate through two handoff slots: the
+      mailbox (latest published frame) and the writer's
+      current frame. Publishing is one atomic exchange; a
+      frame still waiting in the mailbox is replaced by the
+      newer one and counted as dropped.
+    - The mutex and condition variable only park an idle
+      writer thread. The game thread takes the mutex only
+      to signal, and never while a write is in progress.
+===========================================================
+*/
+
+#ifndef WRITER_H
+#define WRITER_H
+
+#include <pthread.h>
+#include <stdatomic.h>
+
+#include "frame.h"
+
+#define WRITER_BUFFERS  3
+
+typedef struct AsyncWriter {
+    FrameBuffer     buffers[WRITER_BUFFERS];
+    long long       publish_ns[WRITER_BUFFERS];
+    int             producer;
+    int             consumer;
+    atomic_int      mailbox;
+    atomic_int      stop;
+    int             running;
+
+    pthread_t       thread;
+    pthread_mutex_t lock;
+    pthread_cond_t  wake;
+
+    atomic_ullong   frames_written;
+    atomic_ullong   frames_replaced;
+    atomic_ullong   bytes_written;
+    atomic_llong    last_lag_ns;
+    atomic_llong    max_lag_ns;
+} AsyncWriter;
+
+int          writer_start(AsyncWriter *writer);
+void         writer_stop(AsyncWriter *writer);
+
+FrameBuffer *writer_frame(AsyncWriter *writer);
+void         writer_publish(AsyncWriter *writer, long long now_ns);
+
+#endif /* WRITER_H */